@@ -406,7 +406,13 @@ EmulatedOPL::EmulatedOPL() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) {
+	_handle(new Audio::SoundHandle()),
+	_renderingAhead(false),
+	_renderBuffer(nullptr),
+	_renderBufferSize(0),
+	_renderReadPos(0),
+	_renderWritePos(0),
+	_renderAheadTarget(0) {
 }
 
 EmulatedOPL::~EmulatedOPL() {
@@ -417,9 +423,39 @@ EmulatedOPL::~EmulatedOPL() {
 	stop();
 
 	delete _handle;
+	delete[] _renderBuffer;
 }
 
 int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
+	if (!_renderingAhead) {
+		renderSamples(buffer, numSamples);
+		return numSamples;
+	}
+
+	// Take what was rendered ahead. The lock is only ever held for
+	// copying, never while the emulator or the callbacks run. The read
+	// and write positions always stay on whole sample frames, so stereo
+	// pairs are never split.
+	Common::StackLock lock(_renderMutex);
+
+	int copied = 0;
+	while (copied < numSamples && _renderReadPos != _renderWritePos) {
+		const uint pos = _renderReadPos & (_renderBufferSize - 1);
+		const uint count = MIN<uint>(MIN<uint>(numSamples - copied, _renderWritePos - _renderReadPos), _renderBufferSize - pos);
+		memcpy(buffer + copied, _renderBuffer + pos, count * sizeof(int16));
+		_renderReadPos += count;
+		copied += count;
+	}
+
+	// The timer fell behind. Rendering here would race with it, so this
+	// is an underrun.
+	if (copied < numSamples)
+		memset(buffer + copied, 0, (numSamples - copied) * sizeof(int16));
+
+	return numSamples;
+}
+
+void EmulatedOPL::renderSamples(int16 *buffer, int numSamples) {
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
@@ -442,8 +478,48 @@ int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 		buffer += step * stereoFactor;
 		len -= step;
 	} while (len);
+}
 
-	return numSamples;
+Common::Array<EmulatedOPL *> EmulatedOPL::_renderAheadInstances;
+Common::Mutex *EmulatedOPL::_renderAheadListMutex = nullptr;
+
+void EmulatedOPL::renderAheadProc(void *refCon) {
+	// Instances are only removed while holding the lock, so none of them
+	// can go away while it renders
+	Common::StackLock lock(*_renderAheadListMutex);
+	for (uint i = 0; i < _renderAheadInstances.size(); i++)
+		_renderAheadInstances[i]->renderAhead();
+}
+
+void EmulatedOPL::renderAhead() {
+	int16 chunk[kRenderAheadChunkSize];
+
+	// This is the only place which runs the emulator and the callbacks
+	// while rendering ahead, so that happens without holding the lock
+	for (;;) {
+		uint count;
+		{
+			Common::StackLock lock(_renderMutex);
+			const uint filled = _renderWritePos - _renderReadPos;
+			if (filled >= _renderAheadTarget)
+				break;
+			count = MIN<uint>(_renderAheadTarget - filled, kRenderAheadChunkSize);
+		}
+
+		if (isStereo())
+			count &= ~1;
+		if (!count)
+			break;
+
+		renderSamples(chunk, count);
+
+		Common::StackLock lock(_renderMutex);
+		const uint pos = _renderWritePos & (_renderBufferSize - 1);
+		const uint first = MIN<uint>(count, _renderBufferSize - pos);
+		memcpy(_renderBuffer + pos, chunk, first * sizeof(int16));
+		memcpy(_renderBuffer, chunk + first, (count - first) * sizeof(int16));
+		_renderWritePos += count;
+	}
 }
 
 int EmulatedOPL::getRate() const {
@@ -452,11 +528,68 @@ int EmulatedOPL::getRate() const {
 
 void EmulatedOPL::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+
+	_renderingAhead = ConfMan.getBool("opl_render_ahead");
+	if (_renderingAhead) {
+		// The mixer takes a whole output buffer per callback, so keep two
+		// of them ready, and at least 40 ms as the timer refills every
+		// 10 ms. The OPL renders at the output rate, so the mixer buffer
+		// size needs no conversion.
+		const uint stereoFactor = isStereo() ? 2 : 1;
+		const uint frames = MAX<uint>(g_system->getMixer()->getOutputBufSize() * 2, getRate() / 25);
+		_renderAheadTarget = frames * stereoFactor;
+
+		uint size = kRenderAheadChunkSize;
+		while (size < _renderAheadTarget)
+			size <<= 1;
+		if (size > _renderBufferSize) {
+			delete[] _renderBuffer;
+			_renderBuffer = new int16[size];
+			_renderBufferSize = size;
+		}
+		_renderReadPos = _renderWritePos = 0;
+	}
+
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+
+	if (!_renderingAhead)
+		return;
+
+	if (!_renderAheadListMutex) {
+		_renderAheadListMutex = new Common::Mutex();
+		_renderAheadInstances.push_back(this);
+		g_system->getTimerManager()->installTimerProc(renderAheadProc, 10000, nullptr, "EmulatedOPL");
+	} else {
+		Common::StackLock lock(*_renderAheadListMutex);
+		_renderAheadInstances.push_back(this);
+	}
 }
 
 void EmulatedOPL::stopCallbacks() {
+	if (_renderingAhead) {
+		bool empty;
+		{
+			Common::StackLock lock(*_renderAheadListMutex);
+			for (uint i = 0; i < _renderAheadInstances.size(); i++) {
+				if (_renderAheadInstances[i] == this) {
+					_renderAheadInstances.remove_at(i);
+					break;
+				}
+			}
+			empty = _renderAheadInstances.empty();
+		}
+
+		// The timer proc is gone once removeTimerProc() returns, so the
+		// mutex can go as well
+		if (empty) {
+			g_system->getTimerManager()->removeTimerProc(renderAheadProc);
+			delete _renderAheadListMutex;
+			_renderAheadListMutex = nullptr;
+		}
+	}
+
 	g_system->getMixer()->stopHandle(*_handle);
+	_renderingAhead = false;
 }
 
 void EmulatedOPL::setCallbackFrequency(int timerFrequency) {
@@ -24,7 +24,9 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
 #include "common/scummsys.h"
 
@@ -268,6 +270,11 @@ private:
  *
  * This will send callbacks based on the number of samples
  * decoded in readBuffer().
+ *
+ * With the "opl_render_ahead" option, the samples and the callbacks are
+ * instead produced ahead of time from a timer proc into a ring buffer,
+ * which readBuffer() then only copies from. This keeps expensive
+ * emulators off the mixer thread, at the cost of some latency.
  */
 class EmulatedOPL : public OPL, protected Audio::AudioStream {
 public:
@@ -310,6 +317,35 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+
+	/**
+	 * Generate samples, running the callbacks at the exact sample
+	 * positions where they are due.
+	 */
+	void renderSamples(int16 *buffer, int numSamples);
+
+	/**
+	 * The timer manager allows a single slot per callback, so one timer
+	 * proc renders ahead for all instances which use the option. The list
+	 * and its mutex only exist while it is not empty.
+	 */
+	static Common::Array<EmulatedOPL *> _renderAheadInstances;
+	static Common::Mutex *_renderAheadListMutex;
+
+	static void renderAheadProc(void *refCon);
+	void renderAhead();
+
+	enum {
+		kRenderAheadChunkSize = 512
+	};
+
+	Common::Mutex _renderMutex;
+	bool _renderingAhead;
+	int16 *_renderBuffer;
+	uint _renderBufferSize;		// int16 values, a power of two
+	uint _renderReadPos;
+	uint _renderWritePos;
+	uint _renderAheadTarget;
 };
 /** @} */
 } // End of namespace OPL
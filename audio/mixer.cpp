@@ -22,6 +22,7 @@
 #include "gui/EventRecorder.h"
 
 #include "common/util.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
@@ -301,6 +302,8 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_SCOPE_TRACK("Mixer::mixCallback", kProfilerTrackAudio);
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
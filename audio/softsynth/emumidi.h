@@ -26,6 +26,10 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/debug.h"
+#include "common/mutex.h"
+#include "common/system.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,12 +47,66 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	int _callbackPosition;
+	uint32 _renderTime;
+	uint32 _renderedSamples;
+
+	void setCallbackPosition(int position) {
+		Common::Mutex *mutex = getEventMutex();
+		if (mutex) {
+			Common::StackLock lock(*mutex);
+			_callbackPosition = position;
+		} else {
+			_callbackPosition = position;
+		}
+	}
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Synths which can queue MIDI events with a sample timestamp return
+	 * true here. readBuffer() then runs all timer callbacks due within
+	 * a mixer buffer first, and renders the whole buffer with a single
+	 * generateSamples() call, instead of one call per callback interval.
+	 */
+	virtual bool supportsTimestampedEvents() const { return false; }
+
+	/**
+	 * The mutex the driver holds while it accepts MIDI events, if events
+	 * may be sent from other threads than the mixer thread. The callback
+	 * position is only changed with this mutex held.
+	 */
+	virtual Common::Mutex *getEventMutex() { return nullptr; }
+
+	/**
+	 * The position, in sample frames from the start of the buffer being
+	 * rendered, of the timer callback currently running in batched mode.
+	 * Events sent at this time have to be queued for that position.
+	 * Returns -1 if events should be played right away.
+	 *
+	 * Must be called with the event mutex held. Events sent by another
+	 * thread while the callbacks of a buffer run are queued at the same
+	 * position. That is where the split rendering would have started
+	 * playing them as well.
+	 */
+	int getCallbackPosition() const { return _callbackPosition; }
+
+	/**
+	 * Print how long rendering took compared to the duration of the
+	 * rendered audio.
+	 */
+	void printRenderStats(const char *name) const {
+		if (!_renderedSamples || !getRate())
+			return;
+		const uint32 audioTime = (uint32)((uint64)_renderedSamples * 1000 / getRate());
+		debug(1, "%s: rendered %u ms of audio in %u ms, %.2f%% of real time", name, audioTime, _renderTime,
+			audioTime ? 100.0 * _renderTime / audioTime : 0.0);
+	}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,6 +115,9 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_callbackPosition(-1),
+		_renderTime(0),
+		_renderedSamples(0),
 		_baseFreq(250) {
 	}
 
@@ -92,6 +153,37 @@ public:
 		int len = numSamples / stereoFactor;
 		int step;
 
+		const uint32 startTime = g_system->getMillis(true);
+		_renderedSamples += len;
+
+		if (supportsTimestampedEvents()) {
+			int pos = 0;
+
+			do {
+				step = len - pos;
+				if (step > (_nextTick >> FIXP_SHIFT))
+					step = (_nextTick >> FIXP_SHIFT);
+
+				pos += step;
+				_nextTick -= step << FIXP_SHIFT;
+				if (!(_nextTick >> FIXP_SHIFT)) {
+					setCallbackPosition(pos);
+					if (_timerProc)
+						(*_timerProc)(_timerParam);
+
+					onTimer();
+					setCallbackPosition(-1);
+
+					_nextTick += _samplesPerTick;
+				}
+			} while (pos < len);
+
+			generateSamples(data, len);
+
+			_renderTime += g_system->getMillis(true) - startTime;
+			return numSamples;
+		}
+
 		do {
 			step = len;
 			if (step > (_nextTick >> FIXP_SHIFT))
@@ -113,6 +205,7 @@ public:
 			len -= step;
 		} while (len);
 
+		_renderTime += g_system->getMillis(true) - startTime;
 		return numSamples;
 	}
 
@@ -501,6 +501,8 @@ void MidiDriver_FluidSynth::close() {
 
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	printRenderStats("FluidSynth");
+
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
 
@@ -36,6 +36,7 @@
 #include "common/system.h"
 #include "common/util.h"
 #include "common/archive.h"
+#include "common/array.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/osd_message_queue.h"
@@ -118,8 +119,13 @@ private:
 
 	int _outputRate;
 
+	MT32Emu::Bit32u getEventTimestamp(int position);
+	void writeSysex(byte channel, const byte *data, uint16 length);
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
+	bool supportsTimestampedEvents() const override { return true; }
+	Common::Mutex *getEventMutex() override { return &_mutex; }
 
 public:
 	MidiDriver_MT32(Audio::Mixer *mixer);
@@ -229,7 +235,45 @@ void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
 	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	const int position = getCallbackPosition();
+	if (position < 0)
+		_service.playMsg(b);
+	else
+		_service.playMsgAt(b, getEventTimestamp(position));
+}
+
+// Returns the synth timestamp of an event sent by the timer callback
+// running at the given position in the buffer which is about to be
+// rendered. Must be called with _mutex held.
+MT32Emu::Bit32u MidiDriver_MT32::getEventTimestamp(int position) {
+	return _service.getInternalRenderedSampleCount() + _service.convertOutputToSynthTimestamp(position);
+}
+
+void MidiDriver_MT32::writeSysex(byte channel, const byte *data, uint16 length) {
+	Common::StackLock lock(_mutex);
+	const int position = getCallbackPosition();
+	if (position < 0) {
+		_service.writeSysex(channel, data, length);
+		return;
+	}
+
+	// writeSysex() takes effect right away, which would let it overtake
+	// the messages queued before it. Queue it as a DT1 message instead.
+	Common::Array<byte> sysex;
+	sysex.resize(length + 7);
+	sysex[0] = 0xF0;
+	sysex[1] = 0x41;
+	sysex[2] = channel;
+	sysex[3] = 0x16;
+	sysex[4] = 0x12;
+	byte checksum = 0;
+	for (uint16 i = 0; i < length; i++) {
+		sysex[5 + i] = data[i];
+		checksum += data[i];
+	}
+	sysex[5 + length] = (128 - (checksum & 0x7F)) & 0x7F;
+	sysex[6 + length] = 0xF7;
+	_service.playSysexAt(sysex.data(), sysex.size(), getEventTimestamp(position));
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
@@ -239,15 +283,18 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 		warning("setPitchBendRange() called with range > 24: %d", range);
 	}
 	byte benderRangeSysex[4] = { 0, 0, 4, (uint8)range };
-	Common::StackLock lock(_mutex);
-	_service.writeSysex(channel, benderRangeSysex, 4);
+	writeSysex(channel, benderRangeSysex, 4);
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
 	if (msg[0] == 0xf0) {
 		Common::StackLock lock(_mutex);
-		_service.playSysex(msg, length);
+		const int position = getCallbackPosition();
+		if (position < 0)
+			_service.playSysex(msg, length);
+		else
+			_service.playSysexAt(msg, length, getEventTimestamp(position));
 	} else {
 		enum {
 			SYSEX_CMD_DT1 = 0x12,
@@ -255,8 +302,7 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 		};
 
 		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
-			Common::StackLock lock(_mutex);
-			_service.writeSysex(msg[1], msg + 4, length - 5);
+			writeSysex(msg[1], msg + 4, length - 5);
 		} else {
 			warning("Unused sysEx command %d", msg[3]);
 		}
@@ -273,6 +319,8 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	printRenderStats("MT-32");
+
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -201,6 +201,15 @@ public:
 	 */
 	virtual Common::SeekableWriteStream *createWriteStream() = 0;
 
+	/**
+	 * Creates a WriteStream instance which writes to a temporary file and
+	 * atomically replaces the file referred by this node once the stream
+	 * is deleted. The default implementation simply writes in place.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableWriteStream *createAtomicWriteStream() { return createWriteStream(); }
+
 	/**
 	* Creates a directory referred by this node.
 	*
@@ -284,6 +284,10 @@ Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
 
+Common::SeekableWriteStream *POSIXFilesystemNode::createAtomicWriteStream() {
+	return PosixIoStream::makeFromPath(getPath(), true, true);
+}
+
 bool POSIXFilesystemNode::createDirectory() {
 	if (mkdir(_path.c_str(), 0755) == 0)
 		setFlags();
@@ -68,6 +68,7 @@ public:
 	Common::SeekableReadStream *createReadStream() override;
 	Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType) override;
 	Common::SeekableWriteStream *createWriteStream() override;
+	Common::SeekableWriteStream *createAtomicWriteStream() override;
 	bool createDirectory() override;
 
 protected:
@@ -25,15 +25,49 @@
 
 #include <sys/stat.h>
 
-PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writeMode) {
+#if defined(POSIX)
+#include <sys/param.h>
+#include <stdlib.h>
+#endif
+
+PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writeMode, bool atomic) {
+	atomic = atomic && writeMode;
+
+#if defined(POSIX)
+	struct stat st;
+	bool exists = false;
+	if (atomic && lstat(path.c_str(), &st) == 0) {
+		// Replace the file a symbolic link points to rather than the link
+		if (S_ISLNK(st.st_mode)) {
+			char target[MAXPATHLEN];
+			if (realpath(path.c_str(), target))
+				return makeFromPath(target, writeMode, atomic);
+			// Dangling link, just write through it
+			atomic = false;
+		}
+		exists = true;
+	}
+#endif
+
+	Common::String openPath = atomic ? path + ".tmp" : path;
+
 #if defined(HAS_FOPEN64)
-	FILE *handle = fopen64(path.c_str(), writeMode ? "wb" : "rb");
+	FILE *handle = fopen64(openPath.c_str(), writeMode ? "wb" : "rb");
 #else
-	FILE *handle = fopen(path.c_str(), writeMode ? "wb" : "rb");
+	FILE *handle = fopen(openPath.c_str(), writeMode ? "wb" : "rb");
 #endif
 
-	if (handle)
-		return new PosixIoStream(handle);
+	if (handle) {
+#if defined(POSIX)
+		// The replacement keeps the permissions of the original file
+		if (atomic && exists)
+			fchmod(fileno(handle), st.st_mode & 07777);
+#endif
+		PosixIoStream *stream = new PosixIoStream(handle);
+		if (atomic)
+			stream->_atomicPath = path;
+		return stream;
+	}
 
 	return nullptr;
 }
@@ -43,6 +77,22 @@ PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
 }
 
+PosixIoStream::~PosixIoStream() {
+	if (_atomicPath.empty())
+		return;
+
+	// Only replace the target once everything made it to the temporary
+	// file; otherwise keep the old file and drop the partial one.
+	FILE *handle = (FILE *)_handle;
+	bool success = fflush(handle) == 0 && !ferror(handle);
+	success = fclose(handle) == 0 && success;
+	_handle = nullptr;
+
+	Common::String tmpPath = _atomicPath + ".tmp";
+	if (!success || rename(tmpPath.c_str(), _atomicPath.c_str()) != 0)
+		remove(tmpPath.c_str());
+}
+
 int64 PosixIoStream::size() const {
 	int fd = fileno((FILE *)_handle);
 	if (fd == -1) {
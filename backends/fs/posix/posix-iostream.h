@@ -29,10 +29,20 @@
  */
 class PosixIoStream final : public StdioStream {
 public:
-	static PosixIoStream *makeFromPath(const Common::String &path, bool writeMode);
+	/**
+	 * Open the file at the given path. In atomic write mode, the data goes
+	 * to a temporary file next to it, which is renamed over the target file
+	 * when the stream is deleted without any write error having occurred.
+	 */
+	static PosixIoStream *makeFromPath(const Common::String &path, bool writeMode, bool atomic = false);
 	PosixIoStream(void *handle);
+	~PosixIoStream() override;
 
 	int64 size() const override;
+
+private:
+	/** Target of an atomic write, empty when writing in place. */
+	Common::String _atomicPath;
 };
 
 #endif
@@ -39,7 +39,8 @@ StdioStream::StdioStream(void *handle) : _handle(handle) {
 }
 
 StdioStream::~StdioStream() {
-	fclose((FILE *)_handle);
+	if (_handle)
+		fclose((FILE *)_handle);
 }
 
 bool StdioStream::err() const {
@@ -34,6 +34,7 @@
 #include "common/translation.h"
 #include "common/algorithm.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/zip-set.h"
 #include "gui/debugger.h"
 #include "engines/engine.h"
@@ -637,6 +638,8 @@ void OpenGLGraphicsManager::updateScreen() {
 		return;
 	}
 
+	PROFILE_SCOPE("OpenGL::updateScreen");
+
 #ifdef USE_OSD
 	if (_osdMessageChangeRequest) {
 		osdMessageUpdateSurface();
@@ -26,6 +26,7 @@
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
 #include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/util.h"
@@ -1179,6 +1180,8 @@ void SurfaceSdlGraphicsManager::updateScreen(SDL_Rect *dirtyRectList, int actual
 }
 
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
+	PROFILE_SCOPE("SurfaceSdl::updateScreen");
+
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
 	int scale1;
@@ -25,6 +25,7 @@ MODULE_OBJS := \
 	midi/timidity.o \
 	saves/savefile.o \
 	saves/default/default-saves.o \
+	saves/default/save-index.o \
 	timer/default/default-timer.o
 
 ifdef USE_CLOUD
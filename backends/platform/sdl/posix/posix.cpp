@@ -47,6 +47,7 @@
 
 #include <stdlib.h>
 #include <errno.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -474,6 +475,22 @@ bool OSystem_POSIX::launchBrowser(const Common::String &client, const Common::St
 }
 #endif
 
+bool OSystem_POSIX::getProcessUsage(uint64 &userMicros, uint64 &systemMicros, uint32 &peakMemoryKB) {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return false;
+
+	userMicros = (uint64)usage.ru_utime.tv_sec * 1000000 + usage.ru_utime.tv_usec;
+	systemMicros = (uint64)usage.ru_stime.tv_sec * 1000000 + usage.ru_stime.tv_usec;
+#ifdef MACOSX
+	// macOS reports the peak in bytes rather than kilobytes
+	peakMemoryKB = usage.ru_maxrss / 1024;
+#else
+	peakMemoryKB = usage.ru_maxrss;
+#endif
+	return true;
+}
+
 AudioCDManager *OSystem_POSIX::createAudioCDManager() {
 #ifdef USE_LINUXCD
 	return createLinuxAudioCDManager();
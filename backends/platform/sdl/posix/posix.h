@@ -30,6 +30,8 @@ public:
 
 	bool displayLogFile() override;
 
+	bool getProcessUsage(uint64 &userMicros, uint64 &systemMicros, uint32 &peakMemoryKB) override;
+
 	void init() override;
 	void initBackend() override;
 
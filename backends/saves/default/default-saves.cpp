@@ -44,6 +44,39 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
+namespace {
+
+/**
+ * Save file which stores the metadata given to it in the save metadata
+ * index once it is finalized, so that the next listing does not need to
+ * read the save back.
+ */
+class IndexedOutSaveFile : public Common::OutSaveFile {
+public:
+	IndexedOutSaveFile(Common::WriteStream *w, Common::SaveFileManager *manager, const Common::String &filename) :
+		Common::OutSaveFile(w), _manager(manager), _filename(filename), _hasMetadata(false) {}
+
+	void setMetadata(const Common::SaveFileMetadata &metadata) override {
+		_metadata = metadata;
+		_hasMetadata = true;
+	}
+
+	void finalize() override {
+		Common::OutSaveFile::finalize();
+		if (_hasMetadata && !err())
+			_manager->setSavefileMetadata(_filename, _metadata);
+		_hasMetadata = false;
+	}
+
+private:
+	Common::SaveFileManager *_manager;
+	Common::String _filename;
+	Common::SaveFileMetadata _metadata;
+	bool _hasMetadata;
+};
+
+} // End of anonymous namespace
+
 DefaultSaveFileManager::DefaultSaveFileManager() {
 }
 
@@ -51,6 +84,10 @@ DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepa
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	flushSavefileMetadata();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -149,6 +186,10 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	saveTimestamps(timestamps);
 #endif
 
+	// Whatever we knew about the old contents is stale now. The entry is
+	// stored again once the new save is finalized, if its metadata is known.
+	_saveIndex.invalidate(filename);
+
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	Common::FSNode fileNode;
@@ -165,7 +206,7 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::OutSaveFile *const result = new IndexedOutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf, this, filename);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -189,6 +230,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 #endif
 
+	_saveIndex.invalidate(filename);
+
 	// Obtain node if exists.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
@@ -219,6 +262,13 @@ Common::ErrorCode DefaultSaveFileManager::removeFile(const Common::FSNode &fileN
 	return Common::kUnknownError;
 }
 
+bool DefaultSaveFileManager::getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime) {
+	// FSNode can not tell the modification time. The size alone would let
+	// a save overwritten by one of the same size show stale metadata, so
+	// the index is not used.
+	return false;
+}
+
 bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
@@ -284,6 +334,10 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 
 	// Build the savefile name cache.
 	for (Common::FSList::const_iterator file = children.begin(), end = children.end(); file != end; ++file) {
+		// The save metadata index is managed internally and not a save file.
+		if (file->getName().equalsIgnoreCase(SaveMetadataIndex::FILENAME))
+			continue;
+
 		if (_saveFileCache.contains(file->getName())) {
 			warning("DefaultSaveFileManager::assureCached: Name clash when building cache, ignoring file '%s'", file->getName().c_str());
 		} else {
@@ -294,6 +348,50 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 	// Only now store that we cached 'savePathName' to indicate we successfully
 	// cached the directory.
 	_cachedDirectory = savePathName;
+
+	_saveIndex.load(savePathName);
+}
+
+bool DefaultSaveFileManager::getSavefileMetadata(const Common::String &filename, Common::SaveFileMetadata &metadata) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	// Only trust the entry if the file is unchanged since it was indexed.
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	uint32 size = 0, mtime = 0;
+	if (file == _saveFileCache.end() || !getFileStamp(file->_value, size, mtime)) {
+		_saveIndex.invalidate(filename);
+		return false;
+	}
+
+	return _saveIndex.lookup(filename, size, mtime, metadata);
+}
+
+void DefaultSaveFileManager::setSavefileMetadata(const Common::String &filename, const Common::SaveFileMetadata &metadata) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return;
+
+	uint32 size, mtime;
+	if (!getFileStamp(file->_value, size, mtime))
+		return;
+
+	_saveIndex.store(filename, size, mtime, metadata);
+}
+
+void DefaultSaveFileManager::flushSavefileMetadata() {
+	// Drop entries of files which disappeared behind our back.
+	if (_cachedDirectory == _saveIndex.getDirectory())
+		_saveIndex.dropMissing(_saveFileCache);
+
+	_saveIndex.flush();
 }
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
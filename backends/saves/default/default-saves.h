@@ -28,6 +28,8 @@
 #include "common/fs.h"
 #include "common/hash-str.h"
 
+#include "backends/saves/default/save-index.h"
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -35,6 +37,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -44,6 +47,10 @@ public:
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
 
+	bool getSavefileMetadata(const Common::String &filename, Common::SaveFileMetadata &metadata) override;
+	void setSavefileMetadata(const Common::String &filename, const Common::SaveFileMetadata &metadata) override;
+	void flushSavefileMetadata() override;
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -75,6 +82,18 @@ protected:
 	 */
 	virtual Common::ErrorCode removeFile(const Common::FSNode &fileNode);
 
+	/**
+	 * Retrieves the size and modification time of the given file. These are
+	 * used to validate entries of the save metadata index.
+	 *
+	 * The default implementation can not query the modification time and
+	 * always fails, which turns the index off. Platforms which can query
+	 * the file system directly should override this.
+	 *
+	 * @return true on success, false if the file can not be accessed.
+	 */
+	virtual bool getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime);
+
 	/**
 	 * Assure that the given save path is cached.
 	 *
@@ -104,6 +123,11 @@ private:
 	 * The currently cached directory.
 	 */
 	Common::Path _cachedDirectory;
+
+	/**
+	 * Metadata of the save files in the cached directory.
+	 */
+	SaveMetadataIndex _saveIndex;
 };
 
 #endif
@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/saves/default/save-index.h"
+
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+
+const char *const SaveMetadataIndex::FILENAME = "saveindex";
+
+enum {
+	kSaveIndexVersion = 1
+};
+
+SaveMetadataIndex::SaveMetadataIndex() : _dirty(false) {
+}
+
+SaveMetadataIndex::~SaveMetadataIndex() {
+	flush();
+}
+
+bool SaveMetadataIndex::lookup(const Common::String &filename, uint32 size, uint32 mtime, Common::SaveFileMetadata &metadata) {
+	Index::const_iterator entry = _index.find(filename);
+	if (entry == _index.end())
+		return false;
+
+	// Only trust the entry if the file is unchanged since it was stored.
+	if (size != entry->_value.size || mtime != entry->_value.mtime) {
+		invalidate(filename);
+		return false;
+	}
+
+	metadata = entry->_value.metadata;
+	return true;
+}
+
+void SaveMetadataIndex::store(const Common::String &filename, uint32 size, uint32 mtime, const Common::SaveFileMetadata &metadata) {
+	Entry &entry = _index[filename];
+	entry.size = size;
+	entry.mtime = mtime;
+	entry.metadata = metadata;
+	_dirty = true;
+}
+
+void SaveMetadataIndex::invalidate(const Common::String &filename) {
+	if (_index.contains(filename)) {
+		_index.erase(filename);
+		_dirty = true;
+	}
+}
+
+static void writeIndexString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint32LE(str.size());
+	out.writeString(str);
+}
+
+static Common::String readIndexString(Common::ReadStream &in) {
+	const uint32 size = in.readUint32LE();
+	Common::String str;
+	for (uint32 i = 0; i < size && !in.eos(); ++i)
+		str += (char)in.readByte();
+	return str;
+}
+
+void SaveMetadataIndex::flush() {
+	if (!_dirty || _directory.empty())
+		return;
+
+	const Common::FSNode indexNode = Common::FSNode(_directory).getChild(FILENAME);
+	Common::ScopedPtr<Common::SeekableWriteStream> out(indexNode.createWriteStream());
+	if (!out) {
+		warning("SaveMetadataIndex: failed to open '%s' file to save the save index", indexNode.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('S', 'V', 'I', 'X'));
+	out->writeUint32LE(kSaveIndexVersion);
+	out->writeUint32LE(_index.size());
+
+	for (Index::const_iterator i = _index.begin(); i != _index.end(); ++i) {
+		const Entry &entry = i->_value;
+		writeIndexString(*out, i->_key);
+		out->writeUint32LE(entry.size);
+		out->writeUint32LE(entry.mtime);
+		writeIndexString(*out, entry.metadata.description);
+		out->writeUint32LE(entry.metadata.saveDate);
+		out->writeUint16LE(entry.metadata.saveTime);
+		out->writeUint32LE(entry.metadata.playTime);
+		out->writeByte(entry.metadata.isAutosave);
+		out->writeUint32LE(entry.metadata.thumbnail.size());
+		if (!entry.metadata.thumbnail.empty())
+			out->write(entry.metadata.thumbnail.data(), entry.metadata.thumbnail.size());
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("SaveMetadataIndex: failed to write save index data into '%s'", indexNode.getPath().toString(Common::Path::kNativeSeparator).c_str());
+
+	_dirty = false;
+}
+
+void SaveMetadataIndex::load(const Common::Path &directory) {
+	if (_directory == directory)
+		return;
+
+	// Write out what we have for the previous directory first.
+	flush();
+
+	_index.clear();
+	_dirty = false;
+	_directory = directory;
+
+	const Common::FSNode indexNode = Common::FSNode(directory).getChild(FILENAME);
+	if (!indexNode.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(indexNode.createReadStream());
+	if (!in)
+		return;
+
+	// Unknown index versions are simply rebuilt on demand.
+	if (in->readUint32BE() != MKTAG('S', 'V', 'I', 'X') || in->readUint32LE() != kSaveIndexVersion)
+		return;
+
+	const uint32 count = in->readUint32LE();
+	for (uint32 i = 0; i < count; ++i) {
+		const Common::String filename = readIndexString(*in);
+
+		Entry entry;
+		entry.size = in->readUint32LE();
+		entry.mtime = in->readUint32LE();
+		entry.metadata.description = readIndexString(*in);
+		entry.metadata.saveDate = in->readUint32LE();
+		entry.metadata.saveTime = in->readUint16LE();
+		entry.metadata.playTime = in->readUint32LE();
+		entry.metadata.isAutosave = in->readByte() != 0;
+
+		const uint32 thumbnailSize = in->readUint32LE();
+		if (thumbnailSize > in->size() - in->pos()) {
+			warning("SaveMetadataIndex: save index '%s' is corrupt, ignoring it", indexNode.getPath().toString(Common::Path::kNativeSeparator).c_str());
+			_index.clear();
+			return;
+		}
+		entry.metadata.thumbnail.resize(thumbnailSize);
+		if (thumbnailSize)
+			in->read(entry.metadata.thumbnail.data(), thumbnailSize);
+
+		if (in->err() || in->eos()) {
+			warning("SaveMetadataIndex: save index '%s' is corrupt, ignoring it", indexNode.getPath().toString(Common::Path::kNativeSeparator).c_str());
+			_index.clear();
+			return;
+		}
+
+		_index[filename] = entry;
+	}
+}
@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKEND_SAVES_SAVE_INDEX_H
+#define BACKEND_SAVES_SAVE_INDEX_H
+
+#include "common/scummsys.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/path.h"
+#include "common/savefile.h"
+#include "common/str.h"
+
+/**
+ * The save metadata index of a save directory. It keeps the metadata of
+ * the saves in the directory in a single file, so that listing them does
+ * not need to open every save. Each entry is tied to the size and the
+ * modification time the save file had when the entry was stored.
+ */
+class SaveMetadataIndex {
+public:
+	/** Name of the index file inside the save directory. */
+	static const char *const FILENAME;
+
+	SaveMetadataIndex();
+	~SaveMetadataIndex();
+
+	/**
+	 * Load the index of the given directory, writing out pending changes
+	 * of the previously loaded directory first. Does nothing if that
+	 * directory is loaded already.
+	 */
+	void load(const Common::Path &directory);
+
+	/**
+	 * Write pending changes to the index file.
+	 */
+	void flush();
+
+	/**
+	 * Look up the entry of a save file. An entry which was stored for
+	 * another size or modification time of the file is dropped.
+	 *
+	 * @return true if a valid entry was found, false otherwise.
+	 */
+	bool lookup(const Common::String &filename, uint32 size, uint32 mtime, Common::SaveFileMetadata &metadata);
+
+	/**
+	 * Store the entry of a save file with the given size and modification
+	 * time.
+	 */
+	void store(const Common::String &filename, uint32 size, uint32 mtime, const Common::SaveFileMetadata &metadata);
+
+	/**
+	 * Drop the entry of a save file, if any.
+	 */
+	void invalidate(const Common::String &filename);
+
+	/**
+	 * Drop the entries of all files which are not contained in @p files.
+	 */
+	template<class T>
+	void dropMissing(const T &files) {
+		for (Index::iterator i = _index.begin(); i != _index.end(); ++i) {
+			if (!files.contains(i->_key)) {
+				_index.erase(i);
+				_dirty = true;
+			}
+		}
+	}
+
+	/** The directory the index belongs to, empty if none is loaded. */
+	const Common::Path &getDirectory() const { return _directory; }
+
+private:
+	struct Entry {
+		uint32 size;
+		uint32 mtime;
+		Common::SaveFileMetadata metadata;
+	};
+
+	typedef Common::HashMap<Common::String, Entry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> Index;
+
+	Index _index;
+	Common::Path _directory;
+	bool _dirty;	///< Whether _index has changes which are not written to disk yet
+};
+
+#endif
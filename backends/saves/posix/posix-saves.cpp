@@ -122,4 +122,14 @@ POSIXSaveFileManager::POSIXSaveFileManager() {
 	}
 }
 
+bool POSIXSaveFileManager::getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime) {
+	struct stat sb;
+	if (stat(fileNode.getPath().toString(Common::Path::kNativeSeparator).c_str(), &sb) != 0)
+		return false;
+
+	size = (uint32)sb.st_size;
+	mtime = (uint32)sb.st_mtime;
+	return true;
+}
+
 #endif
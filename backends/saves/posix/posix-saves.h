@@ -34,6 +34,9 @@
 class POSIXSaveFileManager : public DefaultSaveFileManager {
 public:
 	POSIXSaveFileManager();
+
+protected:
+	bool getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime) override;
 };
 #endif
 
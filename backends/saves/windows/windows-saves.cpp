@@ -54,4 +54,19 @@ WindowsSaveFileManager::WindowsSaveFileManager(bool isPortable) {
 	ConfMan.registerDefault("savepath", Common::Path(Win32::tcharToString(defaultSavepath), Common::Path::kNativeSeparator));
 }
 
+bool WindowsSaveFileManager::getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime) {
+	TCHAR *tPath = Win32::stringToTchar(fileNode.getPath().toString(Common::Path::kNativeSeparator));
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	const BOOL result = GetFileAttributesEx(tPath, GetFileExInfoStandard, &data);
+	free(tPath);
+	if (!result)
+		return false;
+
+	// Save files are far below 4 GB. The low half of the write time changes
+	// every 100 ns and is enough to tell two versions of a file apart.
+	size = data.nFileSizeLow;
+	mtime = data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
 #endif
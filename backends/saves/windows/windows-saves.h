@@ -30,6 +30,9 @@
 class WindowsSaveFileManager final : public DefaultSaveFileManager {
 public:
 	WindowsSaveFileManager(bool isPortable);
+
+protected:
+	bool getFileStamp(const Common::FSNode &fileNode, uint32 &size, uint32 &mtime) override;
 };
 
 #endif
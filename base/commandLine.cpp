@@ -194,8 +194,11 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           info, update, passthrough [default])\n"
+	"                           info, update, benchmark, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --benchmark-baseline=FILE\n"
+	"                           When benchmarking, compare the results against FILE,\n"
+	"                           or store them there if it doesn't exist yet\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
@@ -323,6 +326,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("mt32_device", "null");
 	ConfMan.registerDefault("gm_device", "auto");
 	ConfMan.registerDefault("opl2lpt_parport", "null");
+	ConfMan.registerDefault("opl_render_ahead", false);
 
 	ConfMan.registerDefault("cdrom", 0);
 
@@ -781,6 +785,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("benchmark-baseline")
+			END_OPTION
+
 			DO_LONG_COMMAND("list-records")
 			END_COMMAND
 
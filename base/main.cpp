@@ -43,6 +43,7 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/profiler.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -322,9 +323,21 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	system.getEventManager()->purgeKeyboardEvents();
 	system.getEventManager()->purgeMouseEvents();
 
+#ifdef USE_PROFILER
+	// Record the whole session if requested, to be loaded in chrome://tracing
+	const Common::String profilerTrace = ConfMan.get("profiler_trace");
+	if (!profilerTrace.empty())
+		Common::Profiler::instance().startTrace();
+#endif
+
 	// Run the engine
 	Common::Error result = engine->run();
 
+#ifdef USE_PROFILER
+	if (!profilerTrace.empty())
+		Common::Profiler::instance().stopTrace(Common::Path(profilerTrace, Common::Path::kNativeSeparator));
+#endif
+
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
 		ConfMan.setBool("gui_return_to_launcher_at_exit", false, Common::ConfigManager::kTransientDomain);
@@ -568,6 +581,12 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		}
 	}
 
+#ifdef USE_PROFILER
+	// The audio thread records zones as well, so create the profiler before
+	// the backend starts the mixer, rather than on first use by either thread
+	Common::Profiler::instance();
+#endif
+
 	// Init the backend. Must take place after all config data (including
 	// the command line params) was read.
 	system.initBackend();
@@ -791,6 +810,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderUpdate);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "benchmark") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+				g_eventRec.startBenchmark(ConfMan.get("benchmark_baseline"));
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
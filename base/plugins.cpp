@@ -25,6 +25,8 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
+#include "common/stream.h"
+#include "common/formats/ini-file.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -387,6 +389,89 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	loadPluginIndex();
+}
+
+/**
+ * Read the index of engine plugins, which is stored next to them.
+ **/
+void PluginManagerUncached::loadPluginIndex() {
+	_pluginIndex.clear();
+	_pluginIndexPath.clear();
+	_pluginIndexDirty = false;
+
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		Common::Path filename = (*p)->getFileName();
+		if (!filename.empty()) {
+			_pluginIndexPath = filename.getParent().appendComponent("plugins.idx");
+			break;
+		}
+	}
+	if (_pluginIndexPath.empty())
+		return;
+
+	Common::FSNode node(_pluginIndexPath);
+	if (!node.exists())
+		return;
+
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream)
+		return;
+
+	Common::INIFile index;
+	if (index.loadFromStream(*stream)) {
+		const Common::INIFile::SectionKeyList keys = index.getKeys("engines");
+		for (Common::INIFile::SectionKeyList::const_iterator i = keys.begin(); i != keys.end(); ++i)
+			_pluginIndex[i->key] = i->value;
+	}
+	delete stream;
+
+	debug(9, "Plugin index lists %d engines", _pluginIndex.size());
+}
+
+/**
+ * Write the index of engine plugins back, if any new plugin was found.
+ **/
+void PluginManagerUncached::savePluginIndex() {
+	if (!_pluginIndexDirty || _pluginIndexPath.empty())
+		return;
+
+	// The plugin directory may well be read-only. In that case the index
+	// is only kept in memory, so don't retry until something changes.
+	_pluginIndexDirty = false;
+
+	Common::SeekableWriteStream *stream = Common::FSNode(_pluginIndexPath).createWriteStream(true);
+	if (!stream) {
+		debug(1, "Couldn't write plugin index '%s'", _pluginIndexPath.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	Common::INIFile index;
+	index.addSection("engines");
+	for (PluginIndex::const_iterator i = _pluginIndex.begin(); i != _pluginIndex.end(); ++i)
+		index.setKey(i->_key, "engines", i->_value);
+	index.saveToStream(*stream);
+
+	delete stream;
+}
+
+/**
+ * Remember which engine the given plugin, which must be loaded, provides.
+ **/
+void PluginManagerUncached::addToPluginIndex(const Plugin *plugin) {
+	if (plugin->getType() != PLUGIN_TYPE_ENGINE)
+		return;
+
+	Common::String filename = plugin->getFileName().baseName();
+	if (filename.empty())
+		return;
+
+	Common::String &entry = _pluginIndex.getOrCreateVal(plugin->getName());
+	if (entry != filename) {
+		entry = filename;
+		_pluginIndexDirty = true;
+	}
 }
 
 /**
@@ -394,6 +479,19 @@ void PluginManagerUncached::init() {
  * engine ID under the domain 'engine_plugin_files'.
  **/
 bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineId) {
+	// Look up the plugin index first
+	Common::String indexedFilename;
+	if (_pluginIndex.tryGetVal(engineId, indexedFilename)) {
+		for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+			Common::Path filename = (*p)->getFileName();
+			if (filename.baseName() == indexedFilename) {
+				if (loadPluginByFileName(filename))
+					return true;
+				break;
+			}
+		}
+	}
+
 	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
 
 	if (domain) {
@@ -435,6 +533,7 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::Path &filename) {
 	for (i = _allEnginePlugins.begin(); i != _allEnginePlugins.end(); ++i) {
 		if ((*i)->getFileName() == filename && (*i)->loadPlugin()) {
 			addToPluginsInMemList(*i);
+			addToPluginIndex(*i);
 			_currentPlugin = i;
 			return true;
 		}
@@ -458,6 +557,8 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &engin
 
 		ConfMan.flushToDisk();
 	}
+
+	savePluginIndex();
 }
 
 #ifndef DETECTION_STATIC
@@ -511,6 +612,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToPluginIndex(*_currentPlugin);
 			break;
 		}
 	}
@@ -525,9 +627,13 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToPluginIndex(*_currentPlugin);
 			return true;
 		}
 	}
+
+	// A full scan went through every plugin, so the index is complete now
+	savePluginIndex();
 	return false; // no more in list
 }
 
@@ -660,10 +766,9 @@ DECLARE_SINGLETON(EngineManager);
 
 /**
  * This function works for both cached and uncached PluginManagers.
- * For the cached version, most of the logic here will short circuit.
  *
- * For the uncached version, we first try to find the plugin using the engineId
- * and only if we can't find it there, we loop through the plugins.
+ * Only the MetaEngineDetection objects are queried, which are in memory
+ * without having to load any engine plugin.
  **/
 QualifiedGameList EngineManager::findGamesMatching(const Common::String &engineId, const Common::String &gameId) const {
 	QualifiedGameList results;
@@ -681,11 +786,10 @@ QualifiedGameList EngineManager::findGamesMatching(const Common::String &engineI
 			}
 		}
 	} else {
-		// This is a slow path, we have to scan the list of plugins
-		PluginMan.loadFirstPlugin();
-		do {
-			results.push_back(findGameInLoadedPlugins(gameId));
-		} while (PluginMan.loadNextPlugin());
+		// This is a slow path, we have to ask every engine. This used to cycle
+		// through all engine plugins as well, which is pointless (and
+		// duplicated the results) now that detection lives separately.
+		results = findGameInLoadedPlugins(gameId);
 	}
 
 	return results;
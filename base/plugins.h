@@ -24,6 +24,8 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -362,9 +364,23 @@ protected:
 
 	bool _isDetectionLoaded;
 
-	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
+	/**
+	 * Maps engine IDs to the file name of the plugin providing them, so that
+	 * launching a target only has to load that one plugin. It is kept in a
+	 * file next to the plugins and updated whenever a plugin gets loaded.
+	 */
+	typedef Common::HashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> PluginIndex;
+	PluginIndex _pluginIndex;
+	Common::Path _pluginIndexPath;
+	bool _pluginIndexDirty;
+
+	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr), _pluginIndexDirty(false) {}
 	bool loadPluginByFileName(const Common::Path &filename);
 
+	void loadPluginIndex();
+	void savePluginIndex();
+	void addToPluginIndex(const Plugin *plugin);
+
 public:
 	void init() override;
 	void loadFirstPlugin() override;
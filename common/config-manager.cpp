@@ -50,7 +50,7 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _dirty(true) {
 }
 
 void ConfigManager::defragment() {
@@ -75,6 +75,7 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_dirty = source._dirty;
 }
 
 
@@ -97,6 +98,7 @@ bool ConfigManager::loadDefaultConfigFile(const Path &fallbackFilename) {
 		if (!loadFallbackConfigFile(fallbackFilename))
 			debug("Default configuration file missing, creating a new one");
 
+		_dirty = true;
 		flushToDisk();
 		loadResult = true;
 	}
@@ -111,6 +113,7 @@ bool ConfigManager::loadConfigFile(const Path &filename, const Path &fallbackFil
 	if (!cfg_file.open(node)) {
 		if (!loadFallbackConfigFile(fallbackFilename))
 			debug("Creating configuration file: %s", filename.toString(Common::Path::kNativeSeparator).c_str());
+		_dirty = true;
 	} else {
 		debug("Using configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
 		return loadFromStream(cfg_file);
@@ -128,6 +131,7 @@ bool ConfigManager::loadFallbackConfigFile(const Path &filename) {
 
 	debug("Using initial configuration file: %s", filename.toString(Common::Path::kNativeSeparator).c_str());
 	loadFromStream(fallbackFile);
+	_dirty = true;
 	return true;
 }
 
@@ -135,7 +139,7 @@ bool ConfigManager::loadFallbackConfigFile(const Path &filename) {
  * Add a ready-made domain based on its name and contents
  * The domain name should not already exist in the ConfigManager.
  **/
-void ConfigManager::addDomain(const String &domainName, const ConfigManager::Domain &domain) {
+void ConfigManager::addDomain(const String &domainName, const ConfigManager::Domain &domain, bool isGameDomain) {
 	if (domainName.empty())
 		return;
 	if (domainName == kApplicationDomain) {
@@ -146,7 +150,7 @@ void ConfigManager::addDomain(const String &domainName, const ConfigManager::Dom
 	} else if (domainName == kCloudDomain) {
 		_cloudDomain = domain;
 #endif
-	} else if (domain.contains("gameid")) {
+	} else if (isGameDomain) {
 		// If the domain contains "gameid" we assume it's a game domain
 		if (_gameDomains.contains(domainName))
 			warning("Game domain %s already exists in ConfigManager", domainName.c_str());
@@ -175,6 +179,7 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	String domainName;
 	String comment;
 	Domain domain;
+	bool isGameDomain = false;
 	int lineno = 0;
 
 	_appDomain.clear();
@@ -214,8 +219,10 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 		} else if (line[0] == '[') {
 			// It's a new domain which begins here.
 			// Determine where the previously accumulated domain goes, if we accumulated anything.
-			addDomain(domainName, domain);
-			domain.clear();
+			domain.parse();
+			addDomain(domainName, domain, isGameDomain);
+			domain = Domain();
+			isGameDomain = false;
 			const char *p = line.c_str() + 1;
 			// Get the domain name, and check whether it's valid (that
 			// is, verify that it only consists of alphanumerics,
@@ -233,7 +240,7 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 			domainName = String(line.c_str() + 1, p);
 
-			domain.setDomainComment(comment);
+			domain._domainComment = comment;
 			comment.clear();
 
 		} else {
@@ -261,30 +268,73 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 				return false;
 			}
 
-			// Extract the key/value pair
-			String key(t, p);
-			String value(p + 1);
-
-			// Trim of spaces
-			key.trim();
-			value.trim();
-
-			// Finally, store the key/value pair in the active domain
-			domain.setVal(key, value);
+			// If the domain contains "gameid" we assume it's a game domain
+			if (!isGameDomain) {
+				String key(t, p);
+				key.trim();
+				isGameDomain = key.equalsIgnoreCase("gameid");
+			}
 
-			// Store comment
-			domain.setKVComment(key, comment);
+			// Finally, store the line along with its comment in the active domain.
+			// The lines are split up into key/value pairs once the domain is
+			// complete (see Domain::parse()).
+			domain._source += comment;
+			domain._source += line;
+			domain._source += '\n';
 			comment.clear();
 		}
 	}
 
-	addDomain(domainName, domain); // Add the last domain found
+	domain.parse();
+	addDomain(domainName, domain, isGameDomain); // Add the last domain found
+
+	_dirty = false;
 
 	return true;
 }
 
+bool ConfigManager::isDirty() const {
+	if (_dirty || _appDomain.isDirty() || _keymapperDomain.isDirty())
+		return true;
+#ifdef USE_CLOUD
+	if (_cloudDomain.isDirty())
+		return true;
+#endif
+
+	DomainMap::const_iterator d;
+	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
+		if (d->_value.isDirty())
+			return true;
+	}
+	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
+		if (d->_value.isDirty())
+			return true;
+	}
+
+	return false;
+}
+
+void ConfigManager::markClean() {
+	_dirty = false;
+	_appDomain._dirty = false;
+	_keymapperDomain._dirty = false;
+#ifdef USE_CLOUD
+	_cloudDomain._dirty = false;
+#endif
+
+	DomainMap::iterator d;
+	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d)
+		d->_value._dirty = false;
+	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d)
+		d->_value._dirty = false;
+}
+
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
+	// Nothing to do if the file on disk is still up to date
+	if (!isDirty())
+		return;
+
 	WriteStream *stream;
 
 	if (_filename.empty()) {
@@ -294,16 +344,14 @@ void ConfigManager::flushToDisk() {
 		if (!stream)    // If writing to the config file is not possible, do nothing
 			return;
 	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
+		// Replace the file atomically, so that it never ends up truncated
+		FSNode node(_filename);
+		stream = node.createWriteStream(true);
 
-		if (!dump->open(_filename)) {
+		if (!stream) {
 			warning("Unable to write configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
-			delete dump;
 			return;
 		}
-
-		stream = dump;
 	}
 
 	// Write the application domain
@@ -316,7 +364,7 @@ void ConfigManager::flushToDisk() {
 	writeDomain(*stream, kCloudDomain, _cloudDomain);
 #endif
 
-	DomainMap::const_iterator d;
+	DomainMap::iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
@@ -339,12 +387,19 @@ void ConfigManager::flushToDisk() {
 			writeDomain(*stream, d->_key, d->_value);
 	}
 
+	stream->finalize();
+	bool success = !stream->err();
 	delete stream;
 
+	// Keep everything marked as modified if writing failed, so that the
+	// next flush tries again
+	if (success)
+		markClean();
+
 #endif // !__DC__
 }
 
-void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
+void ConfigManager::writeDomain(WriteStream &stream, const String &name, Domain &domain) {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
 
@@ -354,6 +409,28 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	if (domain.contains("id_came_from_command_line"))
 		return;
 
+	// Only serialize the key/value pairs again if the domain changed since
+	// it was loaded or last written, otherwise reuse the existing text
+	if (domain._dirty || domain._source.empty()) {
+		String &source = domain._source;
+		source.clear();
+
+		// Write all key/value pairs in this domain, including comments
+		Domain::const_iterator x;
+		for (x = domain.begin(); x != domain.end(); ++x) {
+			if (!x->_value.empty()) {
+				// Write comment (if any)
+				if (domain.hasKVComment(x->_key))
+					source += domain.getKVComment(x->_key);
+				// Write the key/value pair
+				source += x->_key;
+				source += '=';
+				source += x->_value;
+				source += '\n';
+			}
+		}
+	}
+
 	String comment;
 
 	// Write domain comment (if any)
@@ -367,22 +444,7 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	stream.writeByte(']');
 	stream.writeByte('\n');
 
-	// Write all key/value pairs in this domain, including comments
-	Domain::const_iterator x;
-	for (x = domain.begin(); x != domain.end(); ++x) {
-		if (!x->_value.empty()) {
-			// Write comment (if any)
-			if (domain.hasKVComment(x->_key)) {
-				comment = domain.getKVComment(x->_key);
-				stream.writeString(comment);
-			}
-			// Write the key/value pair
-			stream.writeString(x->_key);
-			stream.writeByte('=');
-			stream.writeString(x->_value);
-			stream.writeByte('\n');
-		}
-	}
+	stream.writeString(domain._source);
 	stream.writeByte('\n');
 }
 
@@ -707,6 +769,7 @@ void ConfigManager::addGameDomain(const String &domName) {
 	// the given name already exists?
 
 	_gameDomains[domName];
+	_dirty = true;
 
 	// Add it to the _domainSaveOrder, if it's not already in there
 	if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), domName) == _domainSaveOrder.end())
@@ -718,6 +781,7 @@ void ConfigManager::addMiscDomain(const String &domName) {
 	assert(isValidDomainName(domName));
 
 	_miscDomains[domName];
+	_dirty = true;
 }
 
 void ConfigManager::removeGameDomain(const String &domName) {
@@ -728,12 +792,14 @@ void ConfigManager::removeGameDomain(const String &domName) {
 		_activeDomain = nullptr;
 	}
 	_gameDomains.erase(domName);
+	_dirty = true;
 }
 
 void ConfigManager::removeMiscDomain(const String &domName) {
 	assert(!domName.empty());
 	assert(isValidDomainName(domName));
 	_miscDomains.erase(domName);
+	_dirty = true;
 }
 
 
@@ -769,6 +835,7 @@ void ConfigManager::renameDomain(const String &oldName, const String &newName, D
 		newDom.setVal(iter->_key, iter->_value);
 
 	map.erase(oldName);
+	_dirty = true;
 }
 
 bool ConfigManager::hasGameDomain(const String &domName) const {
@@ -787,18 +854,51 @@ bool ConfigManager::isKeyTemporary(const String &key) const {
 
 #pragma mark -
 
+void ConfigManager::Domain::parse() {
+	// Split up the lines collected by loadFromStream(), which were already
+	// validated there: each one is either a comment or a key/value pair.
+	String comment;
+	const char *line = _source.c_str();
+	while (*line) {
+		const char *eol = strchr(line, '\n');
+		assert(eol);
+
+		if (*line == '#') {
+			comment += String(line, eol + 1);
+		} else {
+			while (isSpace(*line))
+				line++;
+			const char *p = strchr(line, '=');
+
+			String key(line, p);
+			String value(p + 1, eol);
+			key.trim();
+			value.trim();
+
+			_entries.setVal(key, value);
+			_keyValueComments.setVal(key, comment);
+			comment.clear();
+		}
+
+		line = eol + 1;
+	}
+}
+
 void ConfigManager::Domain::setDomainComment(const String &comment) {
 	_domainComment = comment;
+	_dirty = true;
 }
 const String &ConfigManager::Domain::getDomainComment() const {
 	return _domainComment;
 }
 
 void ConfigManager::Domain::setKVComment(const String &key, const String &comment) {
+	modify();
 	_keyValueComments[key] = comment;
 }
 const String &ConfigManager::Domain::getKVComment(const String &key) const {
-	return _keyValueComments[key];
+	const StringMap &comments = _keyValueComments;
+	return comments[key];
 }
 bool ConfigManager::Domain::hasKVComment(const String &key) const {
 	return _keyValueComments.contains(key);
@@ -56,13 +56,33 @@ class ConfigManager : public Singleton<ConfigManager> {
 
 public:
 
+	/**
+	 * A configuration domain.
+	 *
+	 * Domains read from the configuration file keep their serialized text
+	 * next to the parsed key/value pairs. The text is written back verbatim
+	 * when the domain has not been modified since it was loaded or last
+	 * flushed, so that only modified domains need to be serialized again.
+	 * Domains are parsed while loading, so the const accessors never write
+	 * and may be called from several threads at once.
+	 */
 	class Domain {
+		friend class ConfigManager;
+
 	private:
 		StringMap _entries;
 		StringMap _keyValueComments;
 		String _domainComment;
 
+		String _source;          /*!< Serialized key/value lines, as found in the configuration file. */
+		bool _dirty;             /*!< Whether the domain was modified since it was loaded or written. */
+
+		void parse();
+		void modify() { _source.clear(); _dirty = true; }
+
 	public:
+		Domain() : _dirty(false) {}
+
 		typedef StringMap::const_iterator const_iterator;
 		const_iterator begin() const { return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
 		const_iterator end()   const { return _entries.end(); }   /*!< Return the ending position of configuration entries. */
@@ -79,11 +99,13 @@ public:
 		 */
 		const String &operator[](const String &key) const { return _entries[key]; }
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { modify(); _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
 
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
-		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
+		/** Return the configuration value for the given key, creating an empty entry if it does not exist.
+		 *  @note Use setVal() to change the value, writing to the returned reference does not mark the domain as modified.
+		 */
+		String &getOrCreateVal(const String &key) { if (!contains(key)) modify(); return _entries.getOrCreateVal(key); }
+		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
 		 /**
 		  * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
 		  * @return True if the key exists, false otherwise.
@@ -92,9 +114,9 @@ public:
 		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
 		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
 
-		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
+		void           clear() { modify(); _entries.clear(); } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { modify(); _entries.erase(key); } /*!< Remove a key from the domain. */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -102,6 +124,8 @@ public:
 		void           setKVComment(const String &key, const String &comment); /*!< Add a key-value @p comment to a @p key. */
 		const String  &getKVComment(const String &key) const; /*!< Retrieve the key-value comment of a @p key. */
 		bool           hasKVComment(const String &key) const; /*!< Check whether a @p key has a key-value comment. */
+
+		bool           isDirty() const { return _dirty; } /*!< Check whether the domain needs to be written to disk. */
 	};
 
 	/** A hash map of existing configuration domains. */
@@ -233,8 +257,10 @@ private:
 
 	bool			loadFallbackConfigFile(const Path &filename);
 	bool			loadFromStream(SeekableReadStream &stream);
-	void			addDomain(const String &domainName, const Domain &domain);
-	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
+	void			addDomain(const String &domainName, const Domain &domain, bool isGameDomain);
+	bool			isDirty() const;
+	void			markClean();
+	void			writeDomain(WriteStream &stream, const String &name, Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
 
 	Domain			_transientDomain;
@@ -257,6 +283,8 @@ private:
 	Domain *		_activeDomain;
 
 	Path			_filename;
+
+	bool			_dirty; // Domains were added, removed or renamed since the last flush
 };
 
 /** @} */
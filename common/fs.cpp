@@ -263,7 +263,7 @@ SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStream
 	return _realNode->createReadStreamForAltStream(altStreamType);
 }
 
-SeekableWriteStream *FSNode::createWriteStream() const {
+SeekableWriteStream *FSNode::createWriteStream(bool atomic) const {
 	if (_realNode == nullptr)
 		return nullptr;
 
@@ -272,6 +272,9 @@ SeekableWriteStream *FSNode::createWriteStream() const {
 		return nullptr;
 	}
 
+	if (atomic)
+		return _realNode->createAtomicWriteStream();
+
 	return _realNode->createWriteStream();
 }
 
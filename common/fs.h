@@ -276,9 +276,15 @@ public:
 	 * referred by this node. This assumes that the node actually refers
 	 * to a readable file. If this is not the case, 0 is returned.
 	 *
+	 * If @p atomic is set, the data is written to a temporary file which
+	 * replaces the target only once the stream is successfully closed, so
+	 * that a crash never leaves a truncated file behind. Backends without
+	 * support for this fall back to writing the file in place.
+	 *
+	 * @param atomic Replace the file atomically when the stream is deleted.
 	 * @return Pointer to the stream object, 0 in case of a failure.
 	 */
-	SeekableWriteStream *createWriteStream() const;
+	SeekableWriteStream *createWriteStream(bool atomic = false) const;
 
 	/**
 	 * Create a directory referred by this node. This assumes that this
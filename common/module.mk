@@ -50,6 +50,11 @@ MODULE_OBJS += \
 	recorderfile.o
 endif
 
+ifdef USE_PROFILER
+MODULE_OBJS += \
+	profiler.o
+endif
+
 ifdef USE_UPDATES
 MODULE_OBJS += \
 	updates.o
@@ -0,0 +1,250 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+
+#include "common/algorithm.h"
+#include "common/file.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#ifdef USE_IMGUI
+#include "backends/imgui/imgui.h"
+#endif
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+Profiler::Profiler() : _numFrameZones(0), _numFrameCounters(0), _frameStart(0), _lastFrameMicros(0),
+		_tracing(false), _trace(nullptr), _traceStart(0), _traceCount(0) {
+	// Reserve the space for the statistics of the last frame up front as well
+	_lastFrameZones.reserve(kMaxZones);
+	_lastFrameCounters.reserve(kMaxCounters);
+}
+
+Profiler::~Profiler() {
+	delete[] _trace;
+}
+
+void Profiler::addTraceEvent(const char *name, ProfilerTrack track, bool isCounter, uint64 start, uint64 duration) {
+	// Once the buffer is full, the oldest events are overwritten
+	TraceEvent &event = _trace[(_traceStart + _traceCount) % kTraceSize];
+	if (_traceCount < kTraceSize)
+		_traceCount++;
+	else
+		_traceStart = (_traceStart + 1) % kTraceSize;
+
+	event.name = name;
+	event.track = track;
+	event.isCounter = isCounter;
+	event.start = start;
+	event.duration = duration;
+}
+
+void Profiler::recordZone(const char *name, ProfilerTrack track, uint64 start, uint64 end) {
+	StackLock lock(_mutex);
+
+	uint64 duration = end - start;
+	uint i = 0;
+	while (i < _numFrameZones && _frameZones[i].name != name && strcmp(_frameZones[i].name, name))
+		i++;
+
+	if (i == _numFrameZones) {
+		if (i < kMaxZones) {
+			ZoneStats &stats = _frameZones[_numFrameZones++];
+			stats.name = name;
+			stats.calls = 1;
+			stats.totalMicros = duration;
+			stats.maxMicros = duration;
+		}
+	} else {
+		ZoneStats &stats = _frameZones[i];
+		stats.calls++;
+		stats.totalMicros += duration;
+		stats.maxMicros = MAX(stats.maxMicros, duration);
+	}
+
+	if (_tracing)
+		addTraceEvent(name, track, false, start, duration);
+}
+
+void Profiler::setCounter(const char *name, int64 value) {
+	StackLock lock(_mutex);
+
+	uint i = 0;
+	while (i < _numFrameCounters && _frameCounters[i].name != name && strcmp(_frameCounters[i].name, name))
+		i++;
+
+	if (i < _numFrameCounters) {
+		_frameCounters[i].value = value;
+	} else if (i < kMaxCounters) {
+		CounterValue &counter = _frameCounters[_numFrameCounters++];
+		counter.name = name;
+		counter.value = value;
+	}
+
+	if (_tracing)
+		addTraceEvent(name, kProfilerTrackMain, true, g_system->getMicros(), (uint64)value);
+}
+
+static bool compareZones(const Profiler::ZoneStats &a, const Profiler::ZoneStats &b) {
+	return a.totalMicros > b.totalMicros;
+}
+
+void Profiler::endFrame() {
+	uint64 now = g_system->getMicros();
+
+	ZoneStats zones[kMaxZones];
+	CounterValue counters[kMaxCounters];
+	uint numZones, numCounters;
+	{
+		StackLock lock(_mutex);
+
+		numZones = _numFrameZones;
+		memcpy(zones, _frameZones, numZones * sizeof(ZoneStats));
+		numCounters = _numFrameCounters;
+		memcpy(counters, _frameCounters, numCounters * sizeof(CounterValue));
+		_numFrameZones = 0;
+		_numFrameCounters = 0;
+	}
+
+	// The statistics of the last frame are only used by this thread
+	_lastFrameMicros = _frameStart ? now - _frameStart : 0;
+	_frameStart = now;
+
+	_lastFrameZones.resize(numZones);
+	for (uint i = 0; i < numZones; i++)
+		_lastFrameZones[i] = zones[i];
+	sort(_lastFrameZones.begin(), _lastFrameZones.end(), compareZones);
+
+	_lastFrameCounters.resize(numCounters);
+	for (uint i = 0; i < numCounters; i++)
+		_lastFrameCounters[i] = counters[i];
+}
+
+void Profiler::startTrace() {
+	// Allocate the buffer before taking the lock, so that it never blocks
+	// the audio thread for long
+	TraceEvent *trace = _trace ? nullptr : new TraceEvent[kTraceSize];
+
+	StackLock lock(_mutex);
+
+	if (trace)
+		_trace = trace;
+	_traceStart = 0;
+	_traceCount = 0;
+	_tracing = true;
+}
+
+bool Profiler::stopTrace(const Path &path) {
+	uint start, count;
+	{
+		StackLock lock(_mutex);
+
+		if (!_tracing)
+			return false;
+		_tracing = false;
+		start = _traceStart;
+		count = _traceCount;
+	}
+
+	// Tracing is off, so the buffer can be written without holding the lock
+	DumpFile file;
+	if (!file.open(path, true)) {
+		warning("Profiler: Could not open '%s' for writing", path.toString(Path::kNativeSeparator).c_str());
+		return false;
+	}
+
+	file.writeString("{\"traceEvents\":[\n");
+	for (uint i = 0; i < count; i++) {
+		const TraceEvent &event = _trace[(start + i) % kTraceSize];
+		String line;
+		if (event.isCounter) {
+			line = String::format("{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"value\":%lld}}",
+			                      event.name, (unsigned long long)event.start, (int)event.track, (long long)(int64)event.duration);
+		} else {
+			line = String::format("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%d}",
+			                      event.name, (unsigned long long)event.start, (unsigned long long)event.duration, (int)event.track);
+		}
+		if (i + 1 < count)
+			line += ",";
+		line += "\n";
+		file.writeString(line);
+	}
+	file.writeString("],\n\"displayTimeUnit\":\"ms\"}\n");
+	file.finalize();
+
+	return !file.err();
+}
+
+#ifdef USE_IMGUI
+void Profiler::drawImGui(bool *open) {
+	const Profiler &profiler = instance();
+
+	if (!ImGui::Begin("Profiler", open)) {
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Text("Frame: %.2f ms", profiler._lastFrameMicros / 1000.0f);
+	if (profiler._tracing)
+		ImGui::Text("Tracing, %u events", profiler._traceCount);
+
+	if (ImGui::BeginTable("zones", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Total (ms)");
+		ImGui::TableSetupColumn("Max (ms)");
+		ImGui::TableHeadersRow();
+		for (uint i = 0; i < profiler._lastFrameZones.size(); i++) {
+			const ZoneStats &stats = profiler._lastFrameZones[i];
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats.name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.totalMicros / 1000.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.maxMicros / 1000.0f);
+		}
+		ImGui::EndTable();
+	}
+
+	for (uint i = 0; i < profiler._lastFrameCounters.size(); i++) {
+		const CounterValue &counter = profiler._lastFrameCounters[i];
+		ImGui::Text("%s: %lld", counter.name, (long long)counter.value);
+	}
+
+	ImGui::End();
+}
+#endif
+
+ProfilerZone::ProfilerZone(const char *name, ProfilerTrack track) : _name(name), _track(track) {
+	_start = g_system->getMicros();
+}
+
+ProfilerZone::~ProfilerZone() {
+	Profiler::instance().recordZone(_name, _track, _start, g_system->getMicros());
+}
+
+} // End of namespace Common
@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief  Lightweight frame-time instrumentation.
+ *
+ * Code is instrumented with the PROFILE_* macros below, which compile to
+ * nothing unless ScummVM was configured with --enable-profiler. The
+ * timings of the last frame can be printed by the "profile" debugger
+ * command or shown in the ImGui debugger of Thimbleweed Park, and a
+ * whole session can be exported in the Chrome trace event format, to be
+ * loaded in chrome://tracing or Perfetto.
+ * @{
+ */
+
+#ifdef USE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/path.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/** Track a zone is shown on in traces, so that zones from different threads don't overlap. */
+enum ProfilerTrack {
+	kProfilerTrackMain = 0,
+	kProfilerTrackAudio = 1
+};
+
+class Profiler : public Singleton<Profiler> {
+public:
+	/** Time spent in a zone during a single frame. */
+	struct ZoneStats {
+		const char *name;
+		uint32 calls;
+		uint64 totalMicros;
+		uint64 maxMicros;
+	};
+
+	/** Last value of a counter during a single frame. */
+	struct CounterValue {
+		const char *name;
+		int64 value;
+	};
+
+	Profiler();
+	~Profiler();
+
+	/**
+	 * Record a finished zone. The name must be a string literal, or otherwise
+	 * stay valid as long as the profiler is used.
+	 */
+	void recordZone(const char *name, ProfilerTrack track, uint64 start, uint64 end);
+	void setCounter(const char *name, int64 value);
+	/** Mark the end of a frame, which makes its statistics available. */
+	void endFrame();
+
+	/** These are only updated by endFrame(), and must be used from the same thread. */
+	uint64 getLastFrameMicros() const { return _lastFrameMicros; }
+	/** Zones of the last frame, sorted by decreasing total time. */
+	const Array<ZoneStats> &getLastFrameZones() const { return _lastFrameZones; }
+	const Array<CounterValue> &getLastFrameCounters() const { return _lastFrameCounters; }
+
+	/**
+	 * Start keeping every zone and counter, until stopTrace() is called.
+	 * Only the most recent events are kept when the trace buffer fills up.
+	 */
+	void startTrace();
+	/**
+	 * Stop tracing, and write the trace as Chrome trace event JSON.
+	 * @return false if the file could not be written.
+	 */
+	bool stopTrace(const Path &path);
+	bool isTracing() const { return _tracing; }
+
+#ifdef USE_IMGUI
+	/**
+	 * Draw the statistics of the last frame in an ImGui window, from an
+	 * ImGui render callback.
+	 * @param open Passed to ImGui::Begin(), cleared when the window is closed.
+	 */
+	static void drawImGui(bool *open = nullptr);
+#endif
+
+private:
+	struct TraceEvent {
+		const char *name;
+		ProfilerTrack track;
+		bool isCounter;
+		uint64 start;
+		uint64 duration; ///< Value of the counter for counter events
+	};
+
+	// Zones can be recorded from the audio thread while the main thread holds
+	// the lock, so nothing is allocated while holding it. Zones and counters
+	// past these limits are not tracked.
+	static const uint kMaxZones = 64;
+	static const uint kMaxCounters = 32;
+	static const uint kTraceSize = 1024 * 1024;
+
+	Mutex _mutex;
+
+	ZoneStats _frameZones[kMaxZones];
+	uint _numFrameZones;
+	CounterValue _frameCounters[kMaxCounters];
+	uint _numFrameCounters;
+	uint64 _frameStart;
+
+	Array<ZoneStats> _lastFrameZones;
+	Array<CounterValue> _lastFrameCounters;
+	uint64 _lastFrameMicros;
+
+	bool _tracing;
+	/** Ring buffer of kTraceSize events, allocated by the first startTrace(). */
+	TraceEvent *_trace;
+	uint _traceStart;
+	uint _traceCount;
+
+	void addTraceEvent(const char *name, ProfilerTrack track, bool isCounter, uint64 start, uint64 duration);
+};
+
+/** Times the enclosing scope. */
+class ProfilerZone {
+public:
+	ProfilerZone(const char *name, ProfilerTrack track = kProfilerTrackMain);
+	~ProfilerZone();
+
+private:
+	const char *_name;
+	ProfilerTrack _track;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#define PROFILE_SCOPE(name) Common::ProfilerZone profilerZone_(name)
+#define PROFILE_SCOPE_TRACK(name, track) Common::ProfilerZone profilerZone_(name, Common::track)
+#define PROFILE_COUNTER(name, value) Common::Profiler::instance().setCounter(name, value)
+#define PROFILE_FRAME() Common::Profiler::instance().endFrame()
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_SCOPE_TRACK(name, track) do {} while (0)
+#define PROFILE_COUNTER(name, value) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+
+#endif
+
+/** @} */
+
+#endif
@@ -22,6 +22,7 @@
 #ifndef COMMON_SAVEFILE_H
 #define COMMON_SAVEFILE_H
 
+#include "common/array.h"
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
 #include "common/stream.h"
@@ -46,6 +47,22 @@ namespace Common {
  */
 typedef SeekableReadStream InSaveFile;
 
+/**
+ * Metadata of a save file, as kept in the save metadata index of save file
+ * managers that support one. The fields mirror the extended savegame header
+ * written by MetaEngine::appendExtendedSave().
+ */
+struct SaveFileMetadata {
+	String description;      /*!< Description of the savegame, UTF-8 encoded. */
+	uint32 saveDate;         /*!< Date of the savegame, packed as in the extended savegame header. */
+	uint16 saveTime;         /*!< Time of the savegame, packed as in the extended savegame header. */
+	uint32 playTime;         /*!< Total play time until this savegame, in milliseconds. */
+	bool isAutosave;         /*!< Whether this savegame is an autosave. */
+	Array<byte> thumbnail;   /*!< Optional scaled-down thumbnail, serialized with Graphics::saveThumbnail(). Empty if none. */
+
+	SaveFileMetadata() : saveDate(0), saveTime(0), playTime(0), isAutosave(false) {}
+};
+
 /**
  * A class which allows game engines to save game state data.
  * That typically means "save games", but also includes things like the
@@ -118,6 +135,14 @@ public:
 	 * This is only supported when creating uncompressed save files.
 	 */
 	int64 size() const override;
+
+	/**
+	 * Provide the metadata of the save being written. Save file managers
+	 * with a save metadata index store it once the file is finalized.
+	 *
+	 * By default, this does nothing.
+	 */
+	virtual void setMetadata(const SaveFileMetadata &metadata) {}
 };
 
 /**
@@ -276,6 +301,36 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Look up the metadata of a save file in the save metadata index.
+	 *
+	 * An entry is only returned if it is still valid, i.e. the save file
+	 * was not modified since the entry was stored.
+	 *
+	 * The default implementation does not keep an index and always fails.
+	 *
+	 * @param name      Name of the save file.
+	 * @param metadata  Receives the metadata if found.
+	 *
+	 * @return true if a valid index entry was found, false otherwise.
+	 */
+	virtual bool getSavefileMetadata(const String &name, SaveFileMetadata &metadata) { return false; }
+
+	/**
+	 * Store the metadata of an existing save file in the save metadata index.
+	 * The entry is tied to the current state of the file and is dropped as
+	 * soon as the file is rewritten or removed.
+	 *
+	 * @param name      Name of the save file.
+	 * @param metadata  Metadata to store.
+	 */
+	virtual void setSavefileMetadata(const String &name, const SaveFileMetadata &metadata) {}
+
+	/**
+	 * Write pending changes of the save metadata index to storage.
+	 */
+	virtual void flushSavefileMetadata() {}
 };
 
 /** @} */
@@ -1505,6 +1505,27 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, relative to an unspecified fixed point.
+	 *
+	 * This is meant for profiling, and is never recorded by the event
+	 * recorder. The default implementation only has the precision of
+	 * getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
+	/**
+	 * Get the CPU time used by the process so far, and its peak resident
+	 * memory. Like getMicros(), this is meant for profiling.
+	 *
+	 * @param userMicros    CPU time spent in user mode, in microseconds.
+	 * @param systemMicros  CPU time spent in the kernel, in microseconds.
+	 * @param peakMemoryKB  Peak resident memory, in kilobytes.
+	 *
+	 * @return True on success, false if this is not supported by the backend.
+	 */
+	virtual bool getProcessUsage(uint64 &userMicros, uint64 &systemMicros, uint32 &peakMemoryKB) { return false; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
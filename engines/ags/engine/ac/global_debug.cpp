@@ -74,6 +74,9 @@ String GetRuntimeInfo() {
 		_G(gfxDriver)->GetDriverName(), filter->GetInfo().Name.GetCStr(),
 		render_frame.GetWidth(), render_frame.GetHeight(),
 		total_spr / 1024, total_normspr / 1024, max_normspr / 1024, norm_spr_filled, total_lockspr / 1024);
+	const SpriteCache::Stats &spr_stats = _GP(spriteset).GetStats();
+	runtimeInfo.AppendFmt("[Sprite cache hits: %u, misses: %u, prefetched: %u, loaded KB: %u",
+		spr_stats.Hits, spr_stats.Misses, spr_stats.Prefetched, (unsigned)(spr_stats.LoadedBytes / 1024));
 	if (_GP(play).separate_music_lib)
 		runtimeInfo.Append("[AUDIO.VOX enabled");
 	if (_GP(play).voice_avail)
@@ -43,6 +43,7 @@
 #include "ags/engine/ac/sys_events.h"
 #include "ags/engine/ac/room.h"
 #include "ags/engine/ac/room_object.h"
+#include "ags/engine/ac/view_frame.h"
 #include "ags/engine/ac/room_status.h"
 #include "ags/engine/ac/screen.h"
 #include "ags/engine/ac/string.h"
@@ -366,6 +367,24 @@ static void adjust_viewport_to_room() {
 	}
 }
 
+// Queue the sprites of the room objects and the characters present in the room
+// for prefetching, so that they get loaded during the spare frame time rather
+// than on the first use
+static void prefetch_room_sprites() {
+	_GP(spriteset).ClearPrefetch();
+	for (size_t cc = 0; cc < _G(croom)->numobj; cc++) {
+		if (!_G(objs)[cc].on)
+			continue;
+		_GP(spriteset).PrefetchSprite(_G(objs)[cc].num);
+		if (_G(objs)[cc].view != RoomObject::NoView)
+			prefetch_view(_G(objs)[cc].view);
+	}
+	for (int cc = 0; cc < _GP(game).numcharacters; cc++) {
+		if ((_GP(game).chars[cc].room == _G(displayed_room)) && _GP(game).chars[cc].on)
+			prefetch_view(_GP(game).chars[cc].view);
+	}
+}
+
 // Run through all viewports and cameras to make sure they can work in new room's bounds
 static void update_all_viewcams_with_newroom() {
 	for (int i = 0; i < _GP(play).GetRoomCameraCount(); ++i) {
@@ -829,6 +848,7 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 		_GP(play).UpdateRoomCameras(); // update auto tracking
 	}
 	init_room_drawdata();
+	prefetch_room_sprites();
 
 	_G(our_eip) = 212;
 	invalidate_screen();
@@ -86,6 +86,9 @@ static bool ShouldStayInWaitMode();
 #define UNTIL_INTISNEG  8
 #define UNTIL_ANIMBTNEND 9
 
+// Time spent each game frame on loading the sprites queued for prefetching
+#define SPRITE_PREFETCH_TIME_MS 2
+
 static void ProperExit() {
 	_G(want_exit) = false;
 	_G(proper_exit) = 1;
@@ -881,6 +884,8 @@ void UpdateGameOnce(bool checkControls, IDriverDependantBitmap *extraBitmap, int
 	if (_G(abort_engine))
 		return;
 
+	_GP(spriteset).ProcessPrefetch(SPRITE_PREFETCH_TIME_MS);
+
 	WaitForNextFrame();
 }
 
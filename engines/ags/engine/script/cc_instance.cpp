@@ -161,6 +161,33 @@ struct ScriptCommands {
 };
 static ScriptCommands *g_commands;
 
+// Superinstructions: common pairs of instructions, which are run as one
+// when executing the prepared code. The second instruction of the pair
+// always takes a single register argument.
+enum ScriptFusedCommand {
+	SCMD_FUSED_LOADSPOFFS_MEMREAD = CC_NUM_SCCMDS, // read local variable
+	SCMD_FUSED_LOADSPOFFS_MEMWRITE,                 // write local variable
+	SCMD_FUSED_LITTOREG_MEMREAD,                    // read global variable (MAR only)
+	SCMD_FUSED_LITTOREG_MEMWRITE,                   // write global variable (MAR only)
+	SCMD_FUSED_END
+};
+
+static const struct {
+	int32_t Fused;
+	int32_t First;
+	int32_t Second;
+} g_fusedCommands[] = {
+	{ SCMD_FUSED_LOADSPOFFS_MEMREAD,  SCMD_LOADSPOFFS, SCMD_MEMREAD },
+	{ SCMD_FUSED_LOADSPOFFS_MEMWRITE, SCMD_LOADSPOFFS, SCMD_MEMWRITE },
+	{ SCMD_FUSED_LITTOREG_MEMREAD,    SCMD_LITTOREG,   SCMD_MEMREAD },
+	{ SCMD_FUSED_LITTOREG_MEMWRITE,   SCMD_LITTOREG,   SCMD_MEMWRITE }
+};
+
+// Prepared instruction entry: command code + 1 in the low bits, and a flag
+// telling that none of the arguments need fixups
+#define PREPARED_CODE_MASK  0x7F
+#define PREPARED_NO_FIXUPS  0x80
+
 void script_commands_init() {
 	g_commands = new ScriptCommands();
 }
@@ -259,6 +286,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_prepared       = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -472,24 +500,35 @@ int ccInstance::Run(int32_t curpc) {
 		*/
 		/* ReadOperation */
 		//=====================================================================
+		// The prepared entries are not used when dumping, as the
+		// superinstructions have no place in the debug output
+		const uint8_t prepared = write_debug_dump ? 0 : codeInst->code_prepared[pc];
 		codeOp.Instruction.Code         = codeInst->code[pc];
 		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
 		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
 
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
-			return -1;
-		}
+		if (prepared != 0) {
+			// already validated when the script was loaded
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			codeOp.Instruction.Code = (prepared & PREPARED_CODE_MASK) - 1;
+		} else {
+			if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+				return -1;
+			}
 
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			if (pc + codeOp.ArgCount >= codeInst->codesize) {
+				cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+				return -1;
+			}
 		}
 
 		int pc_at = pc + 1;
+		// prepared instructions with only numeric literals need no fixups
+		const bool check_fixups = (prepared & PREPARED_NO_FIXUPS) == 0;
 		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
+			char fixup = check_fixups ? codeInst->code_fixups[pc_at] : 0;
 			if (fixup > 0) {
 				// could be relative pointer or import address
 				/*
@@ -1237,6 +1276,34 @@ int ccInstance::Run(int32_t curpc) {
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
+
+		// Superinstructions, only found in the prepared code;
+		// the register argument of the second instruction is validated
+		// by PrepareInstruction()
+		case SCMD_FUSED_LOADSPOFFS_MEMREAD:
+		case SCMD_FUSED_LOADSPOFFS_MEMWRITE:
+		case SCMD_FUSED_LITTOREG_MEMREAD:
+		case SCMD_FUSED_LITTOREG_MEMWRITE: {
+			if (codeOp.Instruction.Code == SCMD_FUSED_LOADSPOFFS_MEMREAD ||
+			        codeOp.Instruction.Code == SCMD_FUSED_LOADSPOFFS_MEMWRITE) {
+				registers[SREG_MAR] = GetStackPtrOffsetRw(arg1.IValue);
+				if (cc_has_error()) {
+					return -1;
+				}
+			} else {
+				registers[SREG_MAR] = arg2;
+			}
+
+			const int32_t next_pc = pc + codeOp.ArgCount + 1;
+			RuntimeScriptValue &next_reg = registers[codeInst->code[next_pc + 1]];
+			if (codeOp.Instruction.Code == SCMD_FUSED_LOADSPOFFS_MEMREAD ||
+			        codeOp.Instruction.Code == SCMD_FUSED_LITTOREG_MEMREAD)
+				next_reg = registers[SREG_MAR].ReadValue();
+			else
+				registers[SREG_MAR].WriteValue(next_reg);
+			pc = next_pc + 2;
+			continue;
+		}
 		default:
 			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
 			return -1;
@@ -1431,6 +1498,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_prepared = joined->code_prepared;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1438,6 +1506,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri.get())) {
 			return false;
 		}
+		PrepareCode();
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1513,9 +1582,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] code_prepared;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_prepared = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1723,12 +1794,58 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		code[fixup] = import_index;
 		// If the call is to another script function next CALLEXT
 		// must be replaced with CALLAS
-		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
+		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT) {
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
+			if (code_prepared[fixup + 1] != 0)
+				code_prepared[fixup + 1] = PrepareInstruction(fixup + 1);
+		}
 	}
 	return true;
 }
 
+void ccInstance::PrepareCode() {
+	code_prepared = new uint8_t[codesize]();
+	// Walk the instructions in order; anything which does not decode
+	// (and any slot which is not an instruction start) is left zeroed,
+	// and will be decoded and validated by Run() as usual
+	for (int32_t at_pc = 0; at_pc < codesize;) {
+		const uint8_t prepared = PrepareInstruction(at_pc);
+		if (prepared == 0)
+			break;
+		code_prepared[at_pc] = prepared;
+		at_pc += (*g_commands)[code[at_pc] & INSTANCE_ID_REMOVEMASK].ArgCount + 1;
+	}
+}
+
+uint8_t ccInstance::PrepareInstruction(int32_t at_pc) const {
+	const intptr_t cmd = code[at_pc] & INSTANCE_ID_REMOVEMASK;
+	if (cmd < 0 || cmd >= CC_NUM_SCCMDS)
+		return 0;
+	const int arg_count = (*g_commands)[cmd].ArgCount;
+	if (at_pc + arg_count >= codesize)
+		return 0;
+
+	bool has_fixups = false;
+	for (int i = 1; i <= arg_count; ++i)
+		has_fixups |= code_fixups[at_pc + i] > 0;
+
+	int32_t prepared = (int32_t)cmd;
+	// Try fusing with the next instruction
+	const int32_t next_pc = at_pc + arg_count + 1;
+	if (next_pc + 1 < codesize && code_fixups[next_pc + 1] == 0 &&
+	        code[next_pc + 1] >= 0 && code[next_pc + 1] < CC_NUM_REGISTERS &&
+	        (cmd != SCMD_LITTOREG || code[at_pc + 1] == SREG_MAR)) {
+		const intptr_t next_cmd = code[next_pc] & INSTANCE_ID_REMOVEMASK;
+		for (const auto &fused : g_fusedCommands) {
+			if (fused.First == cmd && fused.Second == next_cmd) {
+				prepared = fused.Fused;
+				break;
+			}
+		}
+	}
+	return (uint8_t)((prepared + 1) | (has_fixups ? 0 : PREPARED_NO_FIXUPS));
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -139,6 +139,9 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// Instructions pre-decoded at load time, one entry per code slot;
+	// zero for the slots which have to be decoded at runtime
+	uint8_t *code_prepared;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -193,6 +196,9 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Pre-decodes the instructions, fusing the common pairs into superinstructions
+	void    PrepareCode();
+	uint8_t PrepareInstruction(int32_t at_pc) const;
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Begin executing script starting from the given bytecode index
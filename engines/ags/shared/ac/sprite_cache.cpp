@@ -100,7 +100,9 @@ void SpriteCache::Reset() {
 		}
 	}
 	_spriteData.clear();
-	_mru.clear();
+	_mruHead = _mruTail = -1;
+	_mruCount = 0;
+	ClearPrefetch();
 	_cacheSize = 0;
 	_lockedSize = 0;
 }
@@ -149,6 +151,7 @@ void SpriteCache::RemoveSprite(sprkey_t index, bool freeMemory) {
 
 	if (freeMemory)
 		delete _spriteData[index].Image;
+	MruRemove(index);
 	InitNullSpriteParams(index);
 	SprCacheLog("RemoveSprite: %d", index);
 }
@@ -169,6 +172,7 @@ sprkey_t SpriteCache::GetFreeIndex() {
 	for (size_t i = MIN_SPRITE_INDEX; i < _spriteData.size(); ++i) {
 		// slot empty
 		if (!DoesSpriteExist(i)) {
+			MruRemove(i);
 			_sprInfos[i] = SpriteInfo();
 			_spriteData[i] = SpriteData();
 			return i;
@@ -211,18 +215,65 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		return _spriteData[index].Image;
 
 	if (_spriteData[index].Image) {
-		// Move to the beginning of the MRU list
-		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
+		_stats.Hits++;
 	} else {
 		// Sprite exists in file but is not in mem, load it
+		_stats.Misses++;
 		LoadSprite(index);
-		_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
 	}
+	// Move to the beginning of the MRU list
+	MruPushFront(index);
 	return _spriteData[index].Image;
 }
 
+void SpriteCache::MruPushFront(sprkey_t index) {
+	SpriteData &spr = _spriteData[index];
+	if (spr.InMru) {
+		if (_mruHead == index)
+			return;
+		MruRemove(index);
+	}
+	spr.InMru = true;
+	spr.MruPrev = -1;
+	spr.MruNext = _mruHead;
+	if (_mruHead >= 0)
+		_spriteData[_mruHead].MruPrev = index;
+	else
+		_mruTail = index;
+	_mruHead = index;
+	_mruCount++;
+}
+
+void SpriteCache::MruRemove(sprkey_t index) {
+	SpriteData &spr = _spriteData[index];
+	if (!spr.InMru)
+		return;
+	if (spr.MruPrev >= 0)
+		_spriteData[spr.MruPrev].MruNext = spr.MruNext;
+	else
+		_mruHead = spr.MruNext;
+	if (spr.MruNext >= 0)
+		_spriteData[spr.MruNext].MruPrev = spr.MruPrev;
+	else
+		_mruTail = spr.MruPrev;
+	spr.InMru = false;
+	spr.MruPrev = spr.MruNext = -1;
+	_mruCount--;
+}
+
+void SpriteCache::MruClear() {
+	for (sprkey_t i = _mruHead; i >= 0;) {
+		SpriteData &spr = _spriteData[i];
+		i = spr.MruNext;
+		spr.InMru = false;
+		spr.MruPrev = spr.MruNext = -1;
+	}
+	_mruHead = _mruTail = -1;
+	_mruCount = 0;
+}
+
 void SpriteCache::FreeMem(size_t space) {
-	for (int tries = 0; (_mru.size() > 0) && (_cacheSize >= (_maxCacheSize - space)); ++tries) {
+	for (int tries = 0; (_mruCount > 0) && (_cacheSize >= (_maxCacheSize - space)); ++tries) {
 		DisposeOldest();
 		if (tries > 1000) { // ???
 			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "RUNTIME CACHE ERROR: STUCK IN FREE_UP_MEM; RESETTING CACHE");
@@ -232,11 +283,10 @@ void SpriteCache::FreeMem(size_t space) {
 }
 
 void SpriteCache::DisposeOldest() {
-	assert(_mru.size() > 0);
-	if (_mru.size() == 0)
+	assert(_mruCount > 0);
+	if (_mruCount == 0)
 		return;
-	auto it = std::prev(_mru.end());
-	const auto sprnum = *it;
+	const sprkey_t sprnum = _mruTail;
 	// Safety check: must be a sprite from resources
 	// TODO: compare with latest upstream
 	// Commented out the assertion, since it triggers for sprites that are in the list but remapped to the placeholder (sprite 0)
@@ -247,25 +297,19 @@ void SpriteCache::DisposeOldest() {
 	if (!_spriteData[sprnum].IsAssetSprite()) {
 		if (!(_spriteData[sprnum].Flags & SPRCACHEFLAG_REMAPPED))
 			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "SpriteCache::DisposeOldest: in MRU list sprite %d is external or does not exist", sprnum);
-		_mru.erase(it);
-		// std::list::erase() invalidates iterators to the erased item.
-		// But our implementation does not.
-		_spriteData[sprnum].MruIt._node = nullptr;
+		MruRemove(sprnum);
 		return;
 	}
 	// Delete the image, unless is locked
 	// NOTE: locked sprites may still occur in MRU list
 	if (!_spriteData[sprnum].IsLocked()) {
 		_cacheSize -= _spriteData[sprnum].Size;
-		delete _spriteData[*it].Image;
+		delete _spriteData[sprnum].Image;
 		_spriteData[sprnum].Image = nullptr;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
-	_mru.erase(it);
-	// std::list::erase() invalidates iterators to the erased item.
-	// But our implementation does not.
-	_spriteData[sprnum].MruIt._node = nullptr;
+	MruRemove(sprnum);
 }
 
 void SpriteCache::DisposeAll() {
@@ -278,7 +322,7 @@ void SpriteCache::DisposeAll() {
 		}
 	}
 	_cacheSize = _lockedSize;
-	_mru.clear();
+	MruClear();
 }
 
 void SpriteCache::Precache(sprkey_t index) {
@@ -294,10 +338,7 @@ void SpriteCache::Precache(sprkey_t index) {
 	} else if (!_spriteData[index].IsLocked()) {
 		sprSize = _spriteData[index].Size;
 		// Remove locked sprite from the MRU list
-		_mru.erase(_spriteData[index].MruIt);
-		// std::list::erase() invalidates iterators to the erased item.
-		// But our implementation does not.
-		_spriteData[index].MruIt._node = nullptr;
+		MruRemove(index);
 	}
 
 	// make sure locked sprites can't fill the cache
@@ -351,10 +392,73 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	FreeMem(size);
 	_spriteData[index].Size = size;
 	_cacheSize += size;
+	_stats.LoadedBytes += size;
 	SprCacheLog("Loaded %d, size now %zu KB", index, _cacheSize / 1024);
 	return size;
 }
 
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	SpriteData &spr = _spriteData[index];
+	if (!spr.IsAssetSprite() || spr.Image || (spr.Flags & (SPRCACHEFLAG_REMAPPED | SPRCACHEFLAG_PREFETCH)))
+		return;
+	spr.Flags |= SPRCACHEFLAG_PREFETCH;
+	_prefetch.push_back(index);
+}
+
+void SpriteCache::ClearPrefetch() {
+	for (size_t i = _prefetchPos; i < _prefetch.size(); ++i) {
+		if ((size_t)_prefetch[i] < _spriteData.size())
+			_spriteData[_prefetch[i]].Flags &= ~SPRCACHEFLAG_PREFETCH;
+	}
+	_prefetch.clear();
+	_prefetchPos = 0;
+}
+
+size_t SpriteCache::ProcessPrefetch(uint32_t max_time_ms) {
+	const uint32_t start = g_system->getMillis();
+	while (_prefetchPos < _prefetch.size()) {
+		const sprkey_t index = _prefetch[_prefetchPos];
+		SpriteData &spr = _spriteData[index];
+		if (!(spr.Flags & SPRCACHEFLAG_PREFETCH) || spr.Image || !spr.IsAssetSprite() ||
+				(spr.Flags & SPRCACHEFLAG_REMAPPED)) {
+			// got loaded, removed or remapped in the meantime
+			spr.Flags &= ~SPRCACHEFLAG_PREFETCH;
+			_prefetchPos++;
+			continue;
+		}
+		// The final pixel format is not known until the sprite is loaded,
+		// so assume the largest one; stop if that would need to free memory
+		const size_t max_size = _sprInfos[index].Width * _sprInfos[index].Height * 4;
+		if (_cacheSize + max_size >= _maxCacheSize) {
+			ClearPrefetch();
+			break;
+		}
+		if (g_system->getMillis() - start >= max_time_ms)
+			break;
+
+		spr.Flags &= ~SPRCACHEFLAG_PREFETCH;
+		_prefetchPos++;
+		LoadSprite(index);
+		// NOTE: the sprite could have been remapped if it failed to load
+		if (_spriteData[index].Image) {
+			// put to the front, as these are expected to be needed soon
+			MruPushFront(index);
+			_stats.Prefetched++;
+		}
+	}
+	if (_prefetchPos == _prefetch.size()) {
+		_prefetch.clear();
+		_prefetchPos = 0;
+	}
+	return _prefetch.size() - _prefetchPos;
+}
+
+void SpriteCache::ResetStats() {
+	_stats = Stats();
+}
+
 void SpriteCache::RemapSpriteToSprite0(sprkey_t index) {
 	_sprInfos[index].Flags = _sprInfos[0].Flags;
 	_sprInfos[index].Width = _sprInfos[0].Width;
@@ -391,7 +495,6 @@ HError SpriteCache::InitFile(const String &filename, const String &sprindex_file
 	size_t newsize = metrics.size();
 	_sprInfos.resize(newsize);
 	_spriteData.resize(newsize);
-	_mru.clear();
 	for (size_t i = 0; i < metrics.size(); ++i) {
 		if (!metrics[i].IsNull()) {
 			// Existing sprite
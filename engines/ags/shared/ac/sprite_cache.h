@@ -24,7 +24,9 @@
 //
 // SpriteFile handles sprite serialization and streaming.
 // SpriteCache provides bitmaps by demand; it uses SpriteFile to load sprites
-// and does MRU (most-recent-use) caching.
+// and does MRU (most-recent-use) caching. Sprites which are expected to be
+// needed soon may be queued for prefetching, and loaded in small portions
+// when the engine has spare time.
 //
 // TODO: store sprite data in a specialized container type that is optimized
 // for having most keys allocated in large continious sequences by default.
@@ -43,7 +45,6 @@
 
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
-#include "ags/lib/std/list.h"
 #include "ags/shared/ac/sprite_file.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/util/error.h"
@@ -70,6 +71,8 @@ struct SpriteInfo;
 #define SPRCACHEFLAG_REMAPPED       0x02
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED         0x04
+// Tells that the sprite is waiting in the prefetch queue.
+#define SPRCACHEFLAG_PREFETCH       0x08
 
 // Max size of the sprite cache, in bytes
 #if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS
@@ -89,6 +92,14 @@ public:
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
 
+	// Cache usage counters, for diagnostics
+	struct Stats {
+		uint32_t Hits = 0;        // requested sprites which were already loaded
+		uint32_t Misses = 0;      // requested sprites which had to be loaded
+		uint32_t Prefetched = 0;  // sprites loaded ahead of time
+		uint64_t LoadedBytes = 0; // size of all the sprite images loaded from file
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
 
@@ -143,6 +154,19 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Queues the sprite for loading ahead of its first use
+	void        PrefetchSprite(sprkey_t index);
+	// Drops all the queued sprites
+	void        ClearPrefetch();
+	// Loads queued sprites until the given time runs out, or there's no free
+	// cache space left (prefetching never disposes other sprites);
+	// returns the number of sprites still waiting in the queue
+	size_t      ProcessPrefetch(uint32_t max_time_ms);
+	// Gets the cache usage counters
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	void        ResetStats();
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[](sprkey_t index);
@@ -157,6 +181,12 @@ private:
 	void        DisposeOldest();
 	// Keep disposing oldest elements until cache has at least the given free space
 	void        FreeMem(size_t space);
+	// Puts the sprite at the head of the MRU list, unlinking it first if needed
+	void        MruPushFront(sprkey_t index);
+	// Unlinks the sprite from the MRU list, if it's there
+	void        MruRemove(sprkey_t index);
+	// Empties the MRU list
+	void        MruClear();
 
 	// Information required for the sprite streaming
 	struct SpriteData {
@@ -165,8 +195,10 @@ private:
 		// TODO: investigate if we may safely use unique_ptr here
 		// (some of these bitmaps may be assigned from outside of the cache)
 		Shared::Bitmap *Image = nullptr; // actual bitmap
-		// MRU list reference
-		std::list<sprkey_t>::iterator MruIt;
+		// MRU list links, the list is kept right in the sprite slots
+		bool            InMru = false;
+		sprkey_t        MruPrev = -1;
+		sprkey_t        MruNext = -1;
 
 		// Tells if there actually is a registered sprite in this slot
 		bool DoesSpriteExist() const;
@@ -191,8 +223,17 @@ private:
 
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
-	// that were last time used long ago.
-	std::list<sprkey_t> _mru;
+	// that were last time used long ago. This is an intrusive list, linked
+	// through the SpriteData entries, so touching a sprite does not allocate.
+	sprkey_t _mruHead = -1; // most recently used
+	sprkey_t _mruTail = -1; // least recently used
+	size_t   _mruCount = 0;
+
+	// Sprites queued for prefetching, and the position of the next one to load
+	std::vector<sprkey_t> _prefetch;
+	size_t   _prefetchPos = 0;
+
+	Stats    _stats;
 
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/debug.h"
+#include "ags/shared/core/platform.h"
+#include "ags/lib/std/chrono.h"
+#include "ags/shared/util/string_compat.h"
+#include "ags/engine/script/cc_instance.h"
+
+namespace AGS3 {
+
+// A script equivalent to:
+//
+//   int counter;
+//   int bench() {
+//     int i = 0;
+//     do {
+//       i++;
+//       counter += i;
+//     } while (i < BENCH_LOOPS);
+//     return i;
+//   }
+#define BENCH_LOOPS 10000
+
+static const int32_t benchCode[] = {
+	SCMD_LITTOREG, SREG_AX, 0,
+	SCMD_PUSHREG, SREG_AX,
+	// loop start (5)
+	SCMD_LOADSPOFFS, 4,
+	SCMD_MEMREAD, SREG_AX,
+	SCMD_ADD, SREG_AX, 1,
+	SCMD_LOADSPOFFS, 4,
+	SCMD_MEMWRITE, SREG_AX,
+	SCMD_LITTOREG, SREG_MAR, 0, // global data fixup (18)
+	SCMD_MEMREAD, SREG_BX,
+	SCMD_ADDREG, SREG_BX, SREG_AX,
+	SCMD_LITTOREG, SREG_MAR, 0, // global data fixup (26)
+	SCMD_MEMWRITE, SREG_BX,
+	SCMD_LITTOREG, SREG_BX, BENCH_LOOPS,
+	SCMD_LESSTHAN, SREG_AX, SREG_BX,
+	SCMD_JNZ, -32,
+	// loop end (37)
+	SCMD_LOADSPOFFS, 4,
+	SCMD_MEMREAD, SREG_AX,
+	SCMD_SUB, SREG_SP, 4,
+	SCMD_RET
+};
+
+static PScript CreateBenchScript() {
+	PScript scri(new ccScript());
+	scri->codesize = ARRAYSIZE(benchCode);
+	scri->code = (int32_t *)malloc(sizeof(benchCode));
+	memcpy(scri->code, benchCode, sizeof(benchCode));
+	scri->globaldatasize = sizeof(int32_t);
+	scri->globaldata = (char *)calloc(1, scri->globaldatasize);
+	scri->numfixups = 2;
+	scri->fixups = (int32_t *)malloc(scri->numfixups * sizeof(int32_t));
+	scri->fixuptypes = (char *)malloc(scri->numfixups);
+	scri->fixups[0] = 18;
+	scri->fixups[1] = 26;
+	scri->fixuptypes[0] = FIXUP_GLOBALDATA;
+	scri->fixuptypes[1] = FIXUP_GLOBALDATA;
+	// NOTE: ccScript only frees the exports together with the imports
+	scri->imports = (char **)malloc(sizeof(char *));
+	scri->numexports = 1;
+	scri->exports = (char **)malloc(sizeof(char *));
+	scri->exports[0] = ags_strdup("bench$0");
+	scri->export_addr = (int32_t *)malloc(sizeof(int32_t));
+	scri->export_addr[0] = (EXPORT_FUNCTION << 24) | 0;
+	return scri;
+}
+
+static uint32 RunScriptBench(ccInstance *inst, int runs) {
+	uint32 start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < runs; ++i) {
+		memset(inst->globaldata, 0, inst->globaldatasize);
+		int result = inst->CallScriptFunction("bench", 0, nullptr);
+		assert(result == 0);
+		assert(inst->returnValue == BENCH_LOOPS);
+		assert(*(int32_t *)inst->globaldata == BENCH_LOOPS * (BENCH_LOOPS + 1) / 2);
+		(void)result;
+	}
+	return std::chrono::high_resolution_clock::now() - start;
+}
+
+void Test_Script() {
+	const int runs = 100;
+	PScript scri = CreateBenchScript();
+	ccInstance *inst = ccInstance::CreateFromScript(scri);
+	assert(inst);
+
+	uint32 prepared_time = RunScriptBench(inst, runs);
+	// Force the generic decoding of every instruction for comparison
+	memset(inst->code_prepared, 0, inst->codesize);
+	uint32 generic_time = RunScriptBench(inst, runs);
+	delete inst;
+
+	debug("Script bench: %d loops x %d runs, prepared code: %u ms, generic decoding: %u ms",
+		BENCH_LOOPS, runs, prepared_time, generic_time);
+}
+
+} // namespace AGS3
@@ -37,6 +37,10 @@
 
 namespace Director {
 
+// Shared between all channels, so that a render state can never
+// match the one of a different widget
+static uint32 nextWidgetVersion = 0;
+
 Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_score = sc;
 	if (!sp)
@@ -48,6 +52,10 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_currentPoint = _sprite ? _sprite->_startPoint : Common::Point(0, 0);
 	_constraint = 0;
 	_mask = nullptr;
+	_inkCache = nullptr;
+	_inkCacheMask = nullptr;
+	_inkCacheValid = false;
+	_widgetVersion = 0;
 
 	_priority = priority;
 	_width = _sprite ? _sprite->_width : 0;
@@ -79,6 +87,10 @@ Channel& Channel::operator=(const Channel &channel) {
 	_currentPoint = channel._currentPoint;
 	_constraint = channel._constraint;
 	_mask = nullptr;
+	_inkCache = nullptr;
+	_inkCacheMask = nullptr;
+	_inkCacheValid = false;
+	_widgetVersion = 0;
 
 	_priority = channel._priority;
 	_width = channel._width;
@@ -108,6 +120,7 @@ Channel::~Channel() {
 
 	if (_mask)
 		delete _mask;
+	freeInkCache();
 	if (_sprite)
 		delete _sprite;
 }
@@ -203,6 +216,128 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 	return nullptr;
 }
 
+ChannelRenderState Channel::getRenderState() {
+	ChannelRenderState state;
+	if (!_sprite)
+		return state;
+
+	state.castId = _sprite->_castId;
+	state.spriteType = _sprite->_spriteType;
+	state.ink = _sprite->_ink;
+	state.foreColor = _sprite->getForeColor();
+	state.backColor = _sprite->getBackColor();
+	state.blend = _sprite->_blendAmount;
+	state.bbox = getBbox();
+	state.visible = _visible;
+	state.widgetVersion = _widgetVersion;
+	state.paletteGeneration = g_director->getPaletteGeneration();
+
+	return state;
+}
+
+static bool isInkCacheable(const DirectorPlotData &pd) {
+	if (!pd.srf || pd.ms || pd.alpha)
+		return false;
+
+	switch (pd.ink) {
+	case kInkTypeCopy:
+		// Uncolorized copies go straight through the stock blitter
+		return pd.applyColor;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+	case kInkTypeBackgndTrans:
+		return true;
+	case kInkTypeNotCopy:
+		// Without colorization, this matches inverted colors against the palette
+		return pd.applyColor || g_director->_pixelformat.bytesPerPixel != 1;
+	case kInkTypeTransparent:
+	case kInkTypeNotTrans:
+	case kInkTypeGhost:
+	case kInkTypeNotGhost:
+		return pd.applyColor || pd.oneBitImage;
+	default:
+		// Everything else mixes the sprite with what's underneath
+		return false;
+	}
+}
+
+bool Channel::updateInkCache(const DirectorPlotData &pd) {
+	// Film loop channels have no score, and are thrown away after every draw
+	if (!_score || !_sprite->_cast || _sprite->_cast->_type != kCastBitmap || !isInkCacheable(pd)) {
+		freeInkCache();
+		_inkCacheValid = false;
+		return false;
+	}
+
+	// Only the size matters, the cache is reused while the sprite moves around
+	ChannelRenderState state = getRenderState();
+	state.bbox.moveTo(0, 0);
+	state.visible = true;
+
+	if (_inkCacheValid && state == _inkCacheState)
+		return _inkCache != nullptr;
+
+	freeInkCache();
+	_inkCacheState = state;
+	_inkCacheValid = true;
+
+	// Draw the sprite on a black and on a white background. Pixels which come
+	// out the same on both are drawn the same whatever is underneath, and
+	// pixels which were left alone are transparent. If there's anything
+	// else, the ink depends on the background and can't be cached.
+	Common::Rect rect = state.bbox;
+	const Graphics::PixelFormat &format = g_director->_pixelformat;
+	const uint32 white = format.bytesPerPixel == 1 ? 0xff : 0xffffffff;
+	const Graphics::Surface *mask = getMask();
+
+	Graphics::ManagedSurface onBlack(rect.width(), rect.height(), format);
+	Graphics::ManagedSurface onWhite(rect.width(), rect.height(), format);
+	onBlack.fillRect(rect, 0);
+	onWhite.fillRect(rect, white);
+
+	DirectorPlotData probe(pd);
+	probe.dst = &onBlack;
+	probe.destRect = rect;
+	probe.inkBlitSurface(rect, mask);
+	probe.dst = &onWhite;
+	probe.inkBlitSurface(rect, mask);
+
+	Graphics::ManagedSurface *cacheMask = new Graphics::ManagedSurface(rect.width(), rect.height(), Graphics::PixelFormat::createFormatCLUT8());
+
+	for (int y = 0; y < rect.height(); y++) {
+		byte *msk = (byte *)cacheMask->getBasePtr(0, y);
+
+		for (int x = 0; x < rect.width(); x++) {
+			uint32 onBlackPixel = onBlack.getPixel(x, y);
+			uint32 onWhitePixel = onWhite.getPixel(x, y);
+
+			if (onBlackPixel == onWhitePixel) {
+				msk[x] = 1;
+			} else if (onBlackPixel == 0 && onWhitePixel == white) {
+				msk[x] = 0;
+			} else {
+				debugC(5, kDebugImages, "Channel::updateInkCache(): ink %d depends on the background for %s", _sprite->_ink, _sprite->_castId.asString().c_str());
+				delete cacheMask;
+				return false;
+			}
+		}
+	}
+
+	_inkCache = new Graphics::ManagedSurface();
+	_inkCache->copyFrom(onBlack);
+	_inkCacheMask = cacheMask;
+
+	return true;
+}
+
+void Channel::freeInkCache() {
+	delete _inkCache;
+	_inkCache = nullptr;
+	delete _inkCacheMask;
+	_inkCacheMask = nullptr;
+}
+
 // TODO: eliminate this function when we got the correct method to deal with sprite size
 // since we didn't handle sprites very well for text cast members. thus we don't replace our text castmembers when only size changes
 // for explicitly changing, we have isModified to check
@@ -646,6 +781,8 @@ void Channel::replaceWidget(CastMemberID previousCastId, bool force) {
 		return;
 	}
 
+	_widgetVersion = ++nextWidgetVersion;
+
 	if (_widget) {
 		// Check if _widget is of type window, in which case we need to remove it from the window manager
 		if (dynamic_cast<Graphics::MacWindow *>(_widget))
@@ -689,6 +826,7 @@ bool Channel::updateWidget() {
 			_sprite->_cast->updateFromWidget(_widget);
 		}
 		_widget->draw();
+		_widgetVersion = ++nextWidgetVersion;
 		return true;
 	}
 
@@ -36,6 +36,28 @@ class Sprite;
 class Cursor;
 class Score;
 
+// Everything which affects how a channel gets drawn
+struct ChannelRenderState {
+	CastMemberID castId;
+	SpriteType spriteType = kInactiveSprite;
+	InkType ink = kInkTypeCopy;
+	uint32 foreColor = 0;
+	uint32 backColor = 0;
+	int blend = 0;
+	Common::Rect bbox;
+	bool visible = false;
+	uint32 widgetVersion = 0;
+	uint32 paletteGeneration = 0;	// Colorized and matte inks look up colors in the palette
+
+	bool operator==(const ChannelRenderState &s) const {
+		return castId == s.castId && spriteType == s.spriteType && ink == s.ink &&
+			foreColor == s.foreColor && backColor == s.backColor && blend == s.blend &&
+			bbox == s.bbox && visible == s.visible && widgetVersion == s.widgetVersion &&
+			paletteGeneration == s.paletteGeneration;
+	}
+	bool operator!=(const ChannelRenderState &s) const { return !(*this == s); }
+};
+
 class Channel {
 public:
 	Channel(Score *sc, Sprite *sp, int priority = 0);
@@ -46,6 +68,8 @@ public:
 	DirectorPlotData getPlotData();
 	const Graphics::Surface *getMask(bool forceMatte = false);
 	Common::Rect getBbox(bool unstretched = false);
+	ChannelRenderState getRenderState();
+	bool updateInkCache(const DirectorPlotData &pd);
 
 	bool isStretched();
 	bool isDirty(Sprite *nextSprite = nullptr);
@@ -99,6 +123,10 @@ public:
 	Common::Point _currentPoint;
 	Graphics::ManagedSurface *_mask;
 
+	// The sprite with its ink already applied, and which of its pixels are drawn
+	Graphics::ManagedSurface *_inkCache;
+	Graphics::ManagedSurface *_inkCacheMask;
+
 	int _priority;
 	int _width;
 	int _height;
@@ -114,7 +142,13 @@ public:
 
 private:
 	Graphics::ManagedSurface *getSurface();
+	void freeInkCache();
+
 	Score *_score;
+
+	uint32 _widgetVersion;
+	ChannelRenderState _inkCacheState;
+	bool _inkCacheValid;
 };
 
 } // End of namespace Director
@@ -78,6 +78,7 @@ DirectorEngine::DirectorEngine(OSystem *syst, const DirectorGameDescription *gam
 
 	memset(_currentPalette, 0, 768);
 	_currentPaletteLength = 0;
+	_paletteGeneration = 0;
 	_stage = nullptr;
 	_windowList = new Datum;
 	_windowList->type = ARRAY;
@@ -197,6 +197,8 @@ public:
 	const Common::FSNode *getGameDataDir() const { return &_gameDataDir; }
 	const byte *getPalette() const { return _currentPalette; }
 	uint16 getPaletteColorCount() const { return _currentPaletteLength; }
+	/** Bumped whenever the current palette changes, so that caches depending on it can tell. */
+	uint32 getPaletteGeneration() const { return _paletteGeneration; }
 
 	void loadPatterns();
 	Picture *getTile(int num);
@@ -289,6 +291,7 @@ public:
 private:
 	byte _currentPalette[768];
 	uint16 _currentPaletteLength;
+	uint32 _paletteGeneration;
 	Lingo *_lingo;
 	uint16 _version;
 
@@ -344,6 +347,7 @@ struct DirectorPlotData {
 	uint32 preprocessColor(uint32 src);
 	void inkBlitShape(Common::Rect &srcRect);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
+	void inkBlitCached(Common::Rect &srcRect, const Graphics::ManagedSurface *cache, const Graphics::ManagedSurface *cacheMask);
 
 	DirectorPlotData(DirectorEngine *d_, SpriteType s, InkType i, int a, uint32 b, uint32 f) : d(d_), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
 		colorWhite = d->_wm->_colorWhite;
@@ -172,6 +172,7 @@ void DirectorEngine::setPalette(byte *palette, uint16 count) {
 	memset(_currentPalette, 0, 768);
 	memmove(_currentPalette, palette, count * 3);
 	_currentPaletteLength = count;
+	_paletteGeneration++;
 
 	// Pass the palette to OSystem only for 8bpp mode
 	if (_pixelformat.bytesPerPixel == 1)
@@ -202,6 +203,7 @@ void DirectorEngine::shiftPalette(int startIndex, int endIndex, bool reverse) {
 			(span - 1) * 3);
 		memcpy(_currentPalette + 3 * startIndex, temp, 3);
 	}
+	_paletteGeneration++;
 
 	// Pass the palette to OSystem only for 8bpp mode
 	if (_pixelformat.bytesPerPixel == 1)
@@ -723,4 +725,30 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 
 }
 
+void DirectorPlotData::inkBlitCached(Common::Rect &srcRect, const Graphics::ManagedSurface *cache, const Graphics::ManagedSurface *cacheMask) {
+	// The ink has already been applied, so only the drawn pixels need copying
+	int srcX = destRect.left - srcRect.left;
+	int srcY = destRect.top - srcRect.top;
+
+	for (int i = 0; i < destRect.height(); i++) {
+		const byte *msk = (const byte *)cacheMask->getBasePtr(srcX, srcY + i);
+
+		if (d->_wm->_pixelformat.bytesPerPixel == 1) {
+			const byte *src = (const byte *)cache->getBasePtr(srcX, srcY + i);
+			byte *out = (byte *)dst->getBasePtr(destRect.left, destRect.top + i);
+
+			for (int j = 0; j < destRect.width(); j++)
+				if (msk[j])
+					out[j] = src[j];
+		} else {
+			const uint32 *src = (const uint32 *)cache->getBasePtr(srcX, srcY + i);
+			uint32 *out = (uint32 *)dst->getBasePtr(destRect.left, destRect.top + i);
+
+			for (int j = 0; j < destRect.width(); j++)
+				if (msk[j])
+					out[j] = src[j];
+		}
+	}
+}
+
 } // End of namespace Director
@@ -108,13 +108,51 @@ LingoCompiler::LingoCompiler() {
 	_refMode = false;
 
 	_hadError = false;
+	_assemblyCacheable = false;
+}
+
+LingoCompiler::~LingoCompiler() {
+	clearAnonymousCache();
 }
 
 ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code, uint32 preprocFlags) {
+	// do() and value() tend to be called with the same few strings over
+	// and over again, often every frame, so reuse the compiled code.
+	// The "allow outdated Lingo" movie flag affects how code is compiled.
+	const Movie *movie = g_director->getCurrentMovie();
+	const bool allowOutdatedLingo = movie && movie->_allowOutdatedLingo;
+	Common::String key = Common::String::format("%d:%u:%d:", g_director->getVersion(), preprocFlags, allowOutdatedLingo) + code.encode();
+	AnonymousCache::iterator it = _anonymousCache.find(key);
+	if (it != _anonymousCache.end()) {
+		_hadError = false;
+		return it->_value;
+	}
+
 	debugC(1, kDebugCompile, "Compiling anonymous lingo\n"
 			"***********\n%s\n\n***********", code.encode().c_str());
 
-	return compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true, preprocFlags);
+	_assemblyCacheable = true;
+	ScriptContext *sc = compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true, preprocFlags);
+
+	// Code which declares globals or factories changes the global state
+	// while being compiled, so it has to go through the compiler every time
+	if (sc && _assemblyCacheable) {
+		if (_anonymousCache.size() >= kMaxAnonymousCacheSize)
+			clearAnonymousCache();
+
+		sc->incRefCount();
+		_anonymousCache[key] = sc;
+	}
+	_assemblyCacheable = false;
+
+	return sc;
+}
+
+void LingoCompiler::clearAnonymousCache() {
+	// Contexts which are still being executed are kept alive by the call frames
+	for (auto &it : _anonymousCache)
+		it._value->decRefCount();
+	_anonymousCache.clear();
 }
 
 ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonymous, uint32 preprocFlags) {
@@ -392,6 +430,7 @@ void LingoCompiler::registerMethodVar(const Common::String &name, VarType type)
 			if (!_assemblyContext->_properties.contains(name))
 				_assemblyContext->_properties[name] = Datum();
 		} else if (type == kVarGlobal) {
+			_assemblyCacheable = false;
 			if (!g_lingo->_globalvars.contains(name))
 				g_lingo->_globalvars[name] = Datum();
 		}
@@ -402,6 +441,7 @@ void LingoCompiler::registerFactory(Common::String &name) {
 	_assemblyContext->setName(name);
 	_assemblyContext->setFactory(true);
 	g_lingo->_globalvars[name] = _assemblyContext;
+	_assemblyCacheable = false;
 	// Add the factory to the list in the archive
 	if (_assemblyArchive) {
 		if (!_assemblyArchive->factoryContexts.contains(_assemblyId)) {
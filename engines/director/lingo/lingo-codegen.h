@@ -30,7 +30,7 @@ namespace Director {
 class LingoCompiler : NodeVisitor {
 public:
 	LingoCompiler();
-	virtual ~LingoCompiler() {}
+	virtual ~LingoCompiler();
 
 	ScriptContext *compileAnonymous(const Common::U32String &code, uint32 preprocFlags = 0);
 	ScriptContext *compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonyomous = false, uint32 preprocFlags = kLPPNone);
@@ -52,6 +52,7 @@ public:
 	void registerFactory(Common::String &s);
 	void registerMethodVar(const Common::String &name, VarType type = kVarGeneric);
 	void updateLoopJumps(uint nextTargetPos, uint exitTargetPos);
+	void clearAnonymousCache();
 
 	LingoArchive *_assemblyArchive;
 	ScriptContext *_assemblyContext;
@@ -71,6 +72,9 @@ public:
 
 	bool _hadError;
 
+	// Set while compiling anonymous code which can be safely reused
+	bool _assemblyCacheable;
+
 public:
 	virtual bool visitScriptNode(ScriptNode *node);
 	virtual bool visitFactoryNode(FactoryNode *node);
@@ -127,6 +131,10 @@ public:
 private:
 	int parse(const char *code);
 
+	enum { kMaxAnonymousCacheSize = 256 };
+	typedef Common::HashMap<Common::String, ScriptContext *> AnonymousCache;
+	AnonymousCache _anonymousCache;
+
 public:
 	// lingo-preprocessor.cpp
 	Common::U32String codePreprocessor(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, uint32 flags);
@@ -142,7 +142,9 @@ struct Datum {	/* interpreter stack type */
 		PictureReference *picture; /* PICTUREREF */
 	} u;
 
-	int *refCount;
+	// Shared between the copies of a value stored on the heap. Plain values
+	// (VOID, INT, FLOAT, ARGC) don't need one, and leave it as nullptr.
+	mutable int *refCount;
 
 	bool ignoreGlobal; // True if this Datum should be ignored by showGlobals and clearGlobals
 
@@ -185,6 +187,11 @@ struct Datum {	/* interpreter stack type */
 	bool operator<(Datum &d) const;
 	bool operator>=(Datum &d) const;
 	bool operator<=(Datum &d) const;
+
+private:
+	bool isScalar() const;
+	int *shareRefCount() const;
+	void freeValue();
 };
 
 struct ChunkReference {
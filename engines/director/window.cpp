@@ -31,6 +31,7 @@
 #include "director/cast.h"
 #include "director/debugger.h"
 #include "director/lingo/lingo.h"
+#include "director/lingo/lingo-codegen.h"
 #include "director/movie.h"
 #include "director/window.h"
 #include "director/score.h"
@@ -41,6 +42,10 @@
 
 namespace Director {
 
+// How many renders in a row a channel has to stay the same before it
+// can be flattened into the static layer
+static const uint16 kStaticLayerRenders = 10;
+
 Window::Window(int id, bool scrollable, bool resizable, bool editable, Graphics::MacWindowManager *wm, DirectorEngine *vm, bool isStage)
 	: MacWindow(id, scrollable, resizable, editable, wm), Object<Window>("Window") {
 	_vm = vm;
@@ -61,6 +66,11 @@ Window::Window(int id, bool scrollable, bool resizable, bool editable, Graphics:
 	_windowType = -1;
 	_isModal = false;
 
+	_staticLayer = nullptr;
+	_staticLayerChannels = 0;
+	_staticLayerColor = 0;
+	_staticLayerPaletteGeneration = 0;
+
 	updateBorderType();
 
 	_draggable = !_isStage;
@@ -74,6 +84,7 @@ Window::~Window() {
 		delete _frozenLingoStates[i];
 	if (_puppetTransition)
 		delete _puppetTransition;
+	delete _staticLayer;
 }
 
 void Window::decRefCount() {
@@ -142,6 +153,7 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 	if (forceRedraw) {
 		blitTo->clear(_stageColor);
 		markAllDirty();
+		freeStaticLayer();
 	} else {
 		if (_dirtyRects.size() == 0 && _currentMovie->_videoPlayback == false) {
 			if (g_director->_debugDraw & kDebugDrawFrame) {
@@ -158,6 +170,10 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 
 	Channel *hiliteChannel = _currentMovie->getScore()->getChannelById(_currentMovie->_currentHiliteChannelId);
 
+	if (!forceRedraw && blitTo == _composeSurface)
+		updateStaticLayer(hiliteChannel);
+	bool useStaticLayer = _staticLayer && blitTo == _composeSurface;
+
 	uint32 renderStartTime = g_system->getMillis();
 	debugC(7, kDebugImages, "Window::render(): Updating %d rects", _dirtyRects.size());
 
@@ -173,11 +189,18 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 			}
 		}
 
-		if (shouldClear)
+		// With trails, everything underneath has to be drawn over again
+		bool fromStaticLayer = useStaticLayer && shouldClear;
+		if (fromStaticLayer)
+			blitTo->blitFrom(*_staticLayer, r, Common::Point(r.left, r.top));
+		else if (shouldClear)
 			blitTo->fillRect(r, _stageColor);
 
 		for (int pass = 0; pass < 2; pass++) {
 			for (auto &j : _dirtyChannels) {
+				if (fromStaticLayer && j->_priority < (int)_staticLayerChannels)
+					continue;
+
 				if (j->isActiveVideo() && j->isVideoDirectToStage()) {
 					if (pass == 0)
 						continue;
@@ -227,6 +250,82 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 	return true;
 }
 
+bool Window::canFlattenChannel(Channel *channel, Channel *hiliteChannel) {
+	if (channel->isEmpty())
+		return true;
+
+	// Stick to plain bitmaps, which only change when their render state does
+	return channel->_sprite->_cast && channel->_sprite->_cast->_type == kCastBitmap &&
+		channel != hiliteChannel && !channel->isTrail() && !channel->getEditable() &&
+		!channel->isActiveVideo() && !channel->hasSubChannels();
+}
+
+void Window::updateStaticLayer(Channel *hiliteChannel) {
+	Common::Array<Channel *> &channels = _currentMovie->getScore()->_channels;
+
+	if (_channelStates.size() != channels.size()) {
+		freeStaticLayer();
+		_channelStates.resize(channels.size());
+		_unchangedRenders.resize(channels.size());
+		for (uint i = 0; i < _unchangedRenders.size(); i++)
+			_unchangedRenders[i] = 0;
+	}
+
+	if (_staticLayer && (_staticLayerColor != _stageColor || _staticLayerPaletteGeneration != g_director->getPaletteGeneration() ||
+			_staticLayer->w != _composeSurface->w || _staticLayer->h != _composeSurface->h))
+		freeStaticLayer();
+
+	for (uint i = 0; i < channels.size(); i++) {
+		ChannelRenderState state = channels[i]->getRenderState();
+		if (state != _channelStates[i]) {
+			_channelStates[i] = state;
+			_unchangedRenders[i] = 0;
+
+			if (i < _staticLayerChannels)
+				freeStaticLayer();
+		} else if (_unchangedRenders[i] < kStaticLayerRenders) {
+			_unchangedRenders[i]++;
+		}
+
+		if (i < _staticLayerChannels && !canFlattenChannel(channels[i], hiliteChannel))
+			freeStaticLayer();
+	}
+
+	if (_staticLayer)
+		return;
+
+	uint numChannels = 0;
+	bool hasContent = false;
+	while (numChannels < channels.size() && _unchangedRenders[numChannels] >= kStaticLayerRenders &&
+			canFlattenChannel(channels[numChannels], hiliteChannel)) {
+		hasContent |= !channels[numChannels]->isEmpty() && channels[numChannels]->_visible;
+		numChannels++;
+	}
+
+	if (!hasContent)
+		return;
+
+	debugC(5, kDebugImages, "Window::updateStaticLayer(): Flattening %d channels", numChannels);
+
+	_staticLayer = new Graphics::ManagedSurface(_composeSurface->w, _composeSurface->h, _composeSurface->format);
+	_staticLayer->clear(_stageColor);
+	_staticLayerChannels = numChannels;
+	_staticLayerColor = _stageColor;
+	_staticLayerPaletteGeneration = g_director->getPaletteGeneration();
+
+	Common::Rect r(_staticLayer->w, _staticLayer->h);
+	for (uint i = 0; i < numChannels; i++) {
+		if (!channels[i]->isEmpty() && channels[i]->_visible)
+			inkBlitFrom(channels[i], r, _staticLayer);
+	}
+}
+
+void Window::freeStaticLayer() {
+	delete _staticLayer;
+	_staticLayer = nullptr;
+	_staticLayerChannels = 0;
+}
+
 void Window::setStageColor(uint32 stageColor, bool forceReset) {
 	if (stageColor != _stageColor || forceReset) {
 		_stageColor = stageColor;
@@ -309,7 +408,10 @@ void Window::inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::Mana
 	if (pd.ms) {
 		pd.inkBlitShape(srcRect);
 	} else if (pd.srf) {
-		pd.inkBlitSurface(srcRect, channel->getMask());
+		if (channel->updateInkCache(pd))
+			pd.inkBlitCached(srcRect, channel->_inkCache, channel->_inkCacheMask);
+		else
+			pd.inkBlitSurface(srcRect, channel->getMask());
 	} else {
 		if (debugChannelSet(kDebugImages, 4)) {
 			CastType castType = channel->_sprite->_cast ? channel->_sprite->_cast->_type : kCastTypeNull;
@@ -435,6 +537,10 @@ bool Window::loadNextMovie() {
 	delete _currentMovie;
 	_currentMovie = nullptr;
 
+	// Anonymous code compiled for the previous movie may have been compiled
+	// with different settings
+	g_lingo->_compiler->clearAnonymousCache();
+
 	Common::Path archivePath = Common::Path(_currentPath, g_director->_dirSeparator);
 	archivePath.appendInPlace(Common::lastPathComponent(_nextMovie.movie, g_director->_dirSeparator));
 	Archive *mov = g_director->openArchive(archivePath);
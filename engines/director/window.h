@@ -37,6 +37,7 @@ class MacWindowManager;
 namespace Director {
 
 class Channel;
+struct ChannelRenderState;
 class MacArchive;
 struct MacShape;
 struct LingoState;
@@ -216,9 +217,21 @@ private:
 	int _windowType;
 	bool _isModal;
 
+	// Channels at the bottom which haven't changed for a while are drawn
+	// once onto the stage color, and dirty rects start off from that
+	Graphics::ManagedSurface *_staticLayer;
+	uint _staticLayerChannels;
+	uint32 _staticLayerColor;
+	uint32 _staticLayerPaletteGeneration;
+	Common::Array<ChannelRenderState> _channelStates;
+	Common::Array<uint16> _unchangedRenders;
+
 private:
 	void inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::ManagedSurface *blitTo = nullptr);
 	void drawFrameCounter(Graphics::ManagedSurface *blitTo);
+	bool canFlattenChannel(Channel *channel, Channel *hiliteChannel);
+	void updateStaticLayer(Channel *hiliteChannel);
+	void freeStaticLayer();
 
 
 };
@@ -25,6 +25,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -183,6 +184,38 @@ bool MetaEngine::hasFeature(MetaEngineFeature f) const {
 //// Extended Saves
 /////////////////////////////////////////
 
+/**
+ * Convert a parsed extended savegame header into an entry for the save
+ * metadata index. The thumbnail is stored serialized, scaled down if it is
+ * larger than a regular savegame thumbnail.
+ */
+static void createSavefileMetadata(const ExtendedSavegameHeader &header, Common::SaveFileMetadata &metadata) {
+	metadata.description = header.description;
+	metadata.saveDate = header.date;
+	metadata.saveTime = header.time;
+	metadata.playTime = header.playtime;
+	metadata.isAutosave = header.isAutosave;
+	metadata.thumbnail.clear();
+
+	if (!header.thumbnail)
+		return;
+
+	Common::MemoryWriteStreamDynamic thumbnailData(DisposeAfterUse::YES);
+	if (header.thumbnail->w > kThumbnailWidth || header.thumbnail->h > kThumbnailHeight2) {
+		const int scale = MAX((header.thumbnail->w + kThumbnailWidth - 1) / kThumbnailWidth,
+		                      (header.thumbnail->h + kThumbnailHeight2 - 1) / kThumbnailHeight2);
+		Graphics::Surface *scaled = header.thumbnail->scale(header.thumbnail->w / scale, header.thumbnail->h / scale);
+		Graphics::saveThumbnail(thumbnailData, *scaled);
+		scaled->free();
+		delete scaled;
+	} else {
+		Graphics::saveThumbnail(thumbnailData, *header.thumbnail);
+	}
+
+	metadata.thumbnail.resize(thumbnailData.size());
+	memcpy(metadata.thumbnail.data(), thumbnailData.getData(), thumbnailData.size());
+}
+
 void MetaEngine::appendExtendedSave(Common::OutSaveFile *saveFile, uint32 playtime,
 		Common::String desc, bool isAutosave) {
 	appendExtendedSaveToStream(saveFile, playtime, desc, isAutosave);
@@ -222,9 +255,24 @@ void MetaEngine::appendExtendedSaveToStream(Common::WriteStream *saveFile, uint3
 	Graphics::Surface thumb;
 	getSavegameThumbnail(thumb);
 	Graphics::saveThumbnail(*saveFile, thumb);
-	thumb.free();
 
 	saveFile->writeUint32LE(headerPos);	// Store where the header starts
+
+	// Hand the header to the save file manager, so that its save metadata
+	// index does not need to read it back from the new save
+	Common::OutSaveFile *outSaveFile = dynamic_cast<Common::OutSaveFile *>(saveFile);
+	if (outSaveFile) {
+		header.description = desc;
+		header.playtime = playtime;
+		header.isAutosave = isAutosave;
+		header.thumbnail = thumb.getPixels() ? &thumb : nullptr;
+
+		Common::SaveFileMetadata metadata;
+		createSavefileMetadata(header, metadata);
+		outSaveFile->setMetadata(metadata);
+	}
+
+	thumb.free();
 }
 
 bool MetaEngine::copySaveFileToFreeSlot(const char *target, int slot) {
@@ -377,6 +425,9 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		}
 	}
 
+	// Persist whatever querySaveMetaInfos added to the save metadata index.
+	saveFileMan->flushSavefileMetadata();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -441,14 +492,43 @@ SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot)
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String filename = getSavegameFile(slot, target);
+
+	// Try the save metadata index first, which saves us from opening and
+	// parsing the savegame file.
+	Common::SaveFileMetadata metadata;
+	if (saveFileMan->getSavefileMetadata(filename, metadata)) {
+		ExtendedSavegameHeader header;
+		header.description = metadata.description;
+		header.date = metadata.saveDate;
+		header.time = metadata.saveTime;
+		header.playtime = metadata.playTime;
+
+		SaveStateDescriptor desc(this, slot, Common::U32String());
+		parseSavegameHeader(&header, &desc);
+		desc.setAutosave(metadata.isAutosave);
+
+		if (!metadata.thumbnail.empty()) {
+			Common::MemoryReadStream thumbnailData(metadata.thumbnail.data(), metadata.thumbnail.size());
+			Graphics::Surface *thumbnail = nullptr;
+			if (Graphics::loadThumbnail(thumbnailData, thumbnail))
+				desc.setThumbnail(thumbnail);
+		}
+		return desc;
+	}
+
+	Common::ScopedPtr<Common::InSaveFile> f(saveFileMan->openForLoading(filename));
 
 	if (f) {
 		ExtendedSavegameHeader header;
 		if (!readSavegameHeader(f.get(), &header, false)) {
 			return SaveStateDescriptor();
 		}
+		f.reset();
+
+		createSavefileMetadata(header, metadata);
+		saveFileMan->setSavefileMetadata(filename, metadata);
 
 		// Create the return descriptor
 		SaveStateDescriptor desc(this, slot, Common::U32String());
@@ -584,6 +584,33 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 }
 
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	if (_numCachedBoxCoords < 0) {
+		const int numOfBoxes = getNumBoxes();
+		_boxCoordsCache = (BoxCoords *)realloc(_boxCoordsCache, MAX(numOfBoxes, 1) * sizeof(BoxCoords));
+		for (int i = 0; i < numOfBoxes; i++)
+			_boxCoordsCache[i] = readBoxCoordinates(i);
+		_numCachedBoxCoords = numOfBoxes;
+	}
+
+	// Out of range box numbers are left to getBoxBaseAddr() and its workarounds
+	if (boxnum >= 0 && boxnum < _numCachedBoxCoords)
+		return _boxCoordsCache[boxnum];
+	return readBoxCoordinates(boxnum);
+}
+
+void ScummEngine::invalidateBoxCache() {
+	_numCachedBoxCoords = -1;
+	_numNextBoxTableBoxes = -1;
+}
+
+byte *ScummEngine::createBoxResource(ResId idx, uint32 size) {
+	// All box data (rtMatrix 2) and box matrices (rtMatrix 1) must be created
+	// through here, so that the caches never outlive the data they came from
+	invalidateBoxCache();
+	return _res->createResource(rtMatrix, idx, size);
+}
+
+BoxCoords ScummEngine::readBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -728,9 +755,7 @@ byte *ScummEngine::getBoxConnectionBase(int box) {
  */
 int ScummEngine::getNextBox(byte from, byte to) {
 	const byte *boxm;
-	byte i;
 	const int numOfBoxes = getNumBoxes();
-	int dest = -1;
 
 	if (from == to)
 		return to;
@@ -766,6 +791,27 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		return (int8)boxm[to];
 	}
 
+	// WORKAROUND #2: In addition to the truncation check in
+	// buildNextBoxTable(), we have to add this special case to fix the
+	// scene in Indy3 where Indy meets Hitler in Berlin.
+	// See bug #1017 and also bug #1052.
+	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+		return 0;
+
+	if (_numNextBoxTableBoxes != numOfBoxes)
+		buildNextBoxTable(numOfBoxes);
+
+	return _nextBoxTable[from * numOfBoxes + to];
+}
+
+/**
+ * Expands the compressed box matrix of the current room into a table
+ * holding the next box for every pair of boxes, so that getNextBox()
+ * does not have to scan the matrix on each walk step.
+ */
+void ScummEngine::buildNextBoxTable(int numOfBoxes) {
+	const byte *boxm = getBoxMatrixBaseAddr();
+
 	// WORKAROUND #1: It seems that in some cases, the box matrix is corrupt
 	// (more precisely, is too short) in the datafiles already. In
 	// particular this seems to be the case in room 46 of Indy3 EGA (see
@@ -778,31 +824,29 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	// As a workaround, we add a check for the end of the box matrix
 	// resource, and abort the search once we reach the end.
 	const byte *end = boxm + getResourceSize(rtMatrix, 1);
-
-	// WORKAROUND #2: In addition to the above, we have to add this special
-	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
-	// See bug #1017 and also bug #1052.
-	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
-		return 0;
-
-	// Skip up to the matrix data for box 'from'
-	for (i = 0; i < from && boxm < end; i++) {
-		while (boxm < end && *boxm != 0xFF)
+	bool truncated = false;
+
+	_nextBoxTable = (int8 *)realloc(_nextBoxTable, MAX(numOfBoxes * numOfBoxes, 1));
+	memset(_nextBoxTable, -1, MAX(numOfBoxes * numOfBoxes, 1));
+
+	// Each row is a list of (first box, last box, next box) triples,
+	// terminated by 0xFF. Later triples override earlier ones.
+	for (int from = 0; from < numOfBoxes; from++) {
+		int8 *row = _nextBoxTable + from * numOfBoxes;
+		while (boxm + 2 < end && boxm[0] != 0xFF) {
+			for (int to = boxm[0]; to <= boxm[1] && to < numOfBoxes; to++)
+				row[to] = (int8)boxm[2];
 			boxm += 3;
+		}
+		if (boxm >= end || boxm[0] != 0xFF)
+			truncated = true;
 		boxm++;
 	}
 
-	// Now search for the entry for box 'to'
-	while (boxm < end && boxm[0] != 0xFF) {
-		if (boxm[0] <= to && to <= boxm[1])
-			dest = (int8)boxm[2];
-		boxm += 3;
-	}
-
-	if (boxm >= end)
+	if (truncated)
 		debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
 
-	return dest;
+	_numNextBoxTableBoxes = numOfBoxes;
 }
 
 /*
@@ -1055,7 +1099,7 @@ void ScummEngine::createBoxMatrix() {
 	// the boxes 7,8,9,10,11 the shortest way is to go via box 15.
 	// See also getNextBox.
 
-	byte *matrixStart = _res->createResource(rtMatrix, 1, BOX_MATRIX_SIZE);
+	byte *matrixStart = createBoxResource(1, BOX_MATRIX_SIZE);
 	const byte *matrixEnd = matrixStart + BOX_MATRIX_SIZE;
 
 	#define addToMatrix(b)	do { *matrixStart++ = (b); assert(matrixStart < matrixEnd); } while (0)
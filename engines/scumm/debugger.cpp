@@ -297,6 +297,9 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 		} else if (!strcmp(argv[1], "groups") || !strcmp(argv[1], "vols")) {
 			_vm->_imuseDigital->listGroups();
 			return true;
+		} else if (!strcmp(argv[1], "bundleCache")) {
+			_vm->_imuseDigital->listBundleCache();
+			return true;
 		} else if (!strcmp(argv[1], "getParam")) {
 			if (argc > 3) {
 				int result = _vm->_imuseDigital->diMUSEGetParam(atoi(argv[2]), strtol(argv[3], NULL, 16));
@@ -356,6 +359,7 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 	debugPrintf("\thook <soundId> <hookId>          - Set hookId for a sound\n");
 	debugPrintf("\tlist|tracks                      - Display info for every virtual audio track\n");
 	debugPrintf("\tgroups|vols                      - Show volume groups info\n");
+	debugPrintf("\tbundleCache                      - Show bundle block cache statistics\n");
 	debugPrintf("\tgetParam <soundId> <param>       - Get parameter info from a sound\n");
 	debugPrintf("\tsetParam <soundId> <param> <val> - Set parameter value for a sound (dangerous!)\n");
 	debugPrintf("\n");
@@ -1088,6 +1092,15 @@ bool ScummDebugger::Cmd_PrintBox(int argc, const char **argv) {
 }
 
 bool ScummDebugger::Cmd_PrintBoxMatrix(int argc, const char **argv) {
+	if (argc > 1) {
+		if (strcmp(argv[1], "bench")) {
+			debugPrintf("Usage: matrix [bench [iterations]]\n");
+			return true;
+		}
+		benchmarkWalkBoxes(argc > 2 ? atoi(argv[2]) : 10);
+		return true;
+	}
+
 	byte *boxm = _vm->getBoxMatrixBaseAddr();
 	int num = _vm->getNumBoxes();
 	int i, j;
@@ -1135,6 +1148,41 @@ void ScummDebugger::printBox(int box) {
 	drawBox(box, getNextColor());
 }
 
+// Walks every actor of the current room to the middle of every walkbox,
+// following the box matrix, and reports how long that took
+void ScummDebugger::benchmarkWalkBoxes(int iterations) {
+	const int num = _vm->getNumBoxes();
+	int walks = 0, hops = 0;
+
+	if (num == 0) {
+		debugPrintf("This room has no walk boxes\n");
+		return;
+	}
+
+	const uint32 start = g_system->getMillis();
+	for (int n = 0; n < iterations; n++) {
+		for (int i = 1; i < _vm->_numActors; i++) {
+			Actor *a = _vm->_actors[i];
+			if (!a->isInCurrentRoom())
+				continue;
+
+			for (int box = 0; box < num; box++) {
+				const BoxCoords coords = _vm->getBoxCoordinates(box);
+				const AdjustBoxResult abr = a->adjustXYToBeInBox((coords.ul.x + coords.lr.x) / 2, (coords.ul.y + coords.lr.y) / 2);
+
+				int cur = a->_walkbox;
+				for (int step = 0; cur >= 0 && cur != abr.box && step < num; step++) {
+					cur = _vm->getNextBox(cur, abr.box);
+					hops++;
+				}
+				walks++;
+			}
+		}
+	}
+
+	debugPrintf("%d walks over %d boxes, %d box hops in %d ms\n", walks, num, hops, g_system->getMillis() - start);
+}
+
 /************ ENDER: Temporary debug code for boxen **************/
 
 static int gfxPrimitivesCompareInt(const void *a, const void *b);
@@ -77,6 +77,7 @@ private:
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
 	void printBox(int box);
+	void benchmarkWalkBoxes(int iterations);
 	void drawBox(int box, int color);
 	void drawRect(int x, int y, int width, int height, int color);
 	int getNextColor();
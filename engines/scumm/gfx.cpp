@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/system.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
@@ -47,6 +48,12 @@ extern "C" void asmCopy8Col(byte* dst, int dstPitch, const byte* src, int height
 
 namespace Scumm {
 
+#ifdef SCUMMVM_SSE2
+// Composes the text over the game graphics, 16 pixels at a time. Returns
+// the number of pixels done, the caller handles the rest (gfx_sse2.cpp).
+int compositeTextSpanSSE2(byte *dst, const byte *src, const byte *text, int count);
+#endif
+
 static void blit(byte *dst, int dstPitch, const byte *src, int srcPitch, int w, int h, uint8 bitDepth);
 static void fill(byte *dst, int dstPitch, uint16 color, int w, int h, uint8 bitDepth);
 #ifndef USE_ARM_GFX_ASM
@@ -218,9 +225,17 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_stripCacheImage = nullptr;
+	_stripCacheHeight = 0;
+	_stripCacheZPlanes = 0;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
+	_stripCacheActive = false;
+	_stripCachePredecode = false;
 }
 
 Gdi::~Gdi() {
+	resetStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(nullptr) {
@@ -284,9 +299,14 @@ void Gdi::init() {
 		// the backbuf (thus we have to treat the right border separately).
 		_numStrips += 1;
 	}
+
+	// Decode whole rooms when they're first drawn, rather than each strip
+	// when it scrolls into view
+	_stripCachePredecode = ConfMan.hasKey("predecode_rooms") && ConfMan.getBool("predecode_rooms");
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	resetStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -593,27 +613,49 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+	// Neighboring dirty strips are coalesced into one rectangle, so that
+	// the backend gets fewer and bigger updates. Strips with different
+	// dirty ranges are only merged as long as that redraws no more clean
+	// pixels than dirty ones. The NES renderer special cases some exact
+	// rectangle sizes, so there only identical ranges are merged.
+	const bool mergeRanges = (_game.platform != Common::kPlatformNES);
+	int start = -1;
+	int top = 0, bottom = 0, dirtyRows = 0;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		const int stripTop = vs->tdirty[i];
+		const int stripBottom = vs->bdirty[i];
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+
+		if (stripBottom <= stripTop) {
+			if (start >= 0)
+				drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
+			start = -1;
+			continue;
+		}
+
+		if (start >= 0) {
+			const int newTop = MIN(top, stripTop);
+			const int newBottom = MAX(bottom, stripBottom);
+			const bool sameRange = (stripTop == top && stripBottom == bottom);
+			if (sameRange || (mergeRanges && (newBottom - newTop) * (i - start + 1) <= 2 * (dirtyRows + stripBottom - stripTop))) {
+				top = newTop;
+				bottom = newBottom;
+				dirtyRows += stripBottom - stripTop;
 				continue;
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+			drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
 		}
-		start = i + 1;
+
+		start = i;
+		top = stripTop;
+		bottom = stripBottom;
+		dirtyRows = stripBottom - stripTop;
 	}
+
+	if (start >= 0)
+		drawStripToScreen(vs, start * 8, (_gdi->_numStrips - start) * 8, top, bottom);
 }
 
 /**
@@ -730,7 +772,17 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 			const uint32 *text32 = (const uint32 *)text;
 			const int textPitch = (_textSurface.pitch - width * m) >> 2;
 			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
+				int w = width * m;
+#ifdef SCUMMVM_SSE2
+				if (_hasSSE2) {
+					const int done = compositeTextSpanSSE2((byte *)dst32, (const byte *)src32, (const byte *)text32, w);
+					dst32 += done >> 2;
+					src32 += done >> 2;
+					text32 += done >> 2;
+					w -= done;
+				}
+#endif
+				for (; w > 0; w -= 4) {
 					uint32 temp = *text32++;
 
 					// Generate a byte mask for those text pixels (bytes) with
@@ -2103,6 +2155,19 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Only the full room background is cached, as everything else may be
+	// drawn on top of something else, or masked differently
+	_stripCacheActive = canCacheStrips() && !_objectMode && flag == 0 && vs->number == kMainVirtScreen &&
+		y == 0 && height == vs->h && vs->format.bytesPerPixel == 1;
+	if (_stripCacheActive) {
+		// The cache is keyed on the room palette, so let any workaround
+		// change it before the cache is checked and predecoded
+		int smapLen;
+		findStrip(smap_ptr, 0, smapLen);
+		applyRoomPaletteWorkaround(vs, smapLen);
+		prepareStripCache(ptr, smap_ptr, zplane_list, numzbuf, height);
+	}
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -2177,13 +2242,15 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
-bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
-					int stripnr, const byte *smap_ptr) {
+/**
+ * Find the compressed data of a strip in a SMAP block.
+ */
+const byte *Gdi::findStrip(const byte *smap_ptr, int stripnr, int &smapLen) const {
 	// Do some input verification and make sure the strip/strip offset
 	// are actually valid. Normally, this should never be a problem,
 	// but if e.g. a savegame gets corrupted, we can easily get into
 	// trouble here. See also bug #1191.
-	int offset = -1, smapLen;
+	int offset = -1;
 	if (_vm->_game.features & GF_16COLOR) {
 		smapLen = READ_LE_UINT16(smap_ptr);
 		if (stripnr * 2 + 2 < smapLen) {
@@ -2206,16 +2273,10 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 	}
 	assertRange(0, offset, smapLen-1, "screen strip");
 
-	// Indy4 Amiga always uses the room or verb palette map to match colors to
-	// the currently setup palette, thus we need to select it over here too.
-	// Done like the original interpreter.
-	if (_vm->_game.platform == Common::kPlatformAmiga && _vm->_game.id == GID_INDY4) {
-		if (vs->number == kVerbVirtScreen)
-			_roomPalette = _vm->_verbPalette;
-		else
-			_roomPalette = _vm->_roomPalette;
-	}
+	return smap_ptr + offset;
+}
 
+void Gdi::applyRoomPaletteWorkaround(VirtScreen *vs, int smapLen) {
 	// WORKAROUND: 256-color versions of Indy3 feature unusual pink and cyan
 	// horizontal lines when Indy meets Elsa in Berlin. This has only been fixed
 	// in the official FM-TOWNS release (with a few other subtle adjustments),
@@ -2230,6 +2291,24 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 		if (_roomPalette[13] == 13 && _roomPalette[80] == 80)
 			_roomPalette[13] = 80;
 	}
+}
+
+bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
+					int stripnr, const byte *smap_ptr) {
+	int smapLen;
+	const byte *src = findStrip(smap_ptr, stripnr, smapLen);
+
+	// Indy4 Amiga always uses the room or verb palette map to match colors to
+	// the currently setup palette, thus we need to select it over here too.
+	// Done like the original interpreter.
+	if (_vm->_game.platform == Common::kPlatformAmiga && _vm->_game.id == GID_INDY4) {
+		if (vs->number == kVerbVirtScreen)
+			_roomPalette = _vm->_verbPalette;
+		else
+			_roomPalette = _vm->_roomPalette;
+	}
+
+	applyRoomPaletteWorkaround(vs, smapLen);
 
 	// WORKAROUND: In the CD version of MI1, the sign about how the dogs
 	// are only sleeping has a dark blue background instead of white. This
@@ -2240,7 +2319,7 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 	// The SEGA CD version uses the old colors already, and the FM Towns
 	// version makes the text more readable by giving it a black outline.
 
-	else if (_vm->_game.id == GID_MONKEY &&
+	if (_vm->_game.id == GID_MONKEY &&
 			!(_vm->_game.features & GF_ULTIMATE_TALKIE) &&
 			_vm->_game.platform != Common::kPlatformSegaCD &&
 			_vm->_game.platform != Common::kPlatformFMTowns &&
@@ -2250,7 +2329,7 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 			_vm->enhancementEnabled(kEnhVisualChanges)) {
 		_roomPalette[47] = 15;
 
-		byte result = decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+		byte result = decompressBitmap(dstPtr, vs->pitch, src, height);
 
 		_roomPalette[47] = 47;
 		return result;
@@ -2271,13 +2350,16 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 			_vm->enhancementEnabled(kEnhVisualChanges)) {
 		_roomPalette[1] = 15;
 
-		byte result = decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+		byte result = decompressBitmap(dstPtr, vs->pitch, src, height);
 
 		_roomPalette[1] = 1;
 		return result;
 	}
 
-	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+	if (_stripCacheActive && stripnr >= 0 && stripnr < (int)_stripCache.size())
+		return decompressCachedBitmap(dstPtr, vs->pitch, src, stripnr, height);
+
+	return decompressBitmap(dstPtr, vs->pitch, src, height);
 }
 
 bool GdiNES::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
@@ -2349,22 +2431,16 @@ void Gdi::decodeMask(int x, int y, const int width, const int height,
 				decompressMaskImg(mask_ptr, z_plane_ptr, height);
 		}
 	} else {
+		if (_stripCacheActive && restoreCachedMask(x, y, stripnr, numzbuf, zplane_list, height))
+			return;
+
 		for (i = 1; i < numzbuf; i++) {
 			uint32 offs;
 
 			if (!zplane_list[i])
 				continue;
 
-			if (_vm->_game.features & GF_OLD_BUNDLE)
-				offs = READ_LE_UINT16(zplane_list[i] + stripnr * 2);
-			else if (_vm->_game.features & GF_OLD256)
-				offs = READ_LE_UINT16(zplane_list[i] + stripnr * 2 + 4);
-			else if (_vm->_game.features & GF_SMALL_HEADER)
-				offs = READ_LE_UINT16(zplane_list[i] + stripnr * 2 + 2);
-			else if (_vm->_game.version == 8)
-				offs = READ_LE_UINT32(zplane_list[i] + stripnr * 4 + 8);
-			else
-				offs = READ_LE_UINT16(zplane_list[i] + stripnr * 2 + 8);
+			offs = getZPlaneOffset(zplane_list[i], stripnr);
 
 			mask_ptr = getMaskBuffer(x, y, i);
 
@@ -2383,9 +2459,25 @@ void Gdi::decodeMask(int x, int y, const int width, const int height,
 						mask_ptr[h * _numStrips] = 0;
 			}
 		}
+
+		if (_stripCacheActive)
+			storeCachedMask(x, y, stripnr, numzbuf, zplane_list, height);
 	}
 }
 
+uint32 Gdi::getZPlaneOffset(const byte *zplane, int stripnr) const {
+	if (_vm->_game.features & GF_OLD_BUNDLE)
+		return READ_LE_UINT16(zplane + stripnr * 2);
+	else if (_vm->_game.features & GF_OLD256)
+		return READ_LE_UINT16(zplane + stripnr * 2 + 4);
+	else if (_vm->_game.features & GF_SMALL_HEADER)
+		return READ_LE_UINT16(zplane + stripnr * 2 + 2);
+	else if (_vm->_game.version == 8)
+		return READ_LE_UINT32(zplane + stripnr * 4 + 8);
+	else
+		return READ_LE_UINT16(zplane + stripnr * 2 + 8);
+}
+
 void GdiHE::decodeMask(int x, int y, const int width, const int height,
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) {
@@ -2452,6 +2544,110 @@ void GdiV2::decodeMask(int x, int y, const int width, const int height,
 	// Do nothing here for V2 games - zplane was already handled.
 }
 
+void Gdi::resetStripCache() {
+	for (uint i = 0; i < _stripCache.size(); i++) {
+		free(_stripCache[i].pixels);
+		free(_stripCache[i].masks);
+	}
+	_stripCache.clear();
+	_stripCacheImage = nullptr;
+}
+
+/**
+ * Make sure the cached strips match the room image about to be drawn, and
+ * the room palette they were decoded with.
+ */
+void Gdi::prepareStripCache(const byte *ptr, const byte *smap_ptr, const byte *zplane_list[9], int numzbuf, int height) {
+	if (_stripCacheImage == ptr && _stripCacheHeight == height && _stripCacheZPlanes == numzbuf &&
+		!memcmp(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette)))
+		return;
+
+	resetStripCache();
+	_stripCacheImage = ptr;
+	_stripCacheHeight = height;
+	_stripCacheZPlanes = numzbuf;
+	memcpy(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette));
+
+	CachedStrip emptyStrip;
+	emptyStrip.pixels = nullptr;
+	emptyStrip.masks = nullptr;
+	emptyStrip.transparent = false;
+	_stripCache.resize(MAX<int>(_vm->_roomWidth / 8, 0), emptyStrip);
+
+	if (_stripCachePredecode) {
+		// Only the main screen is cached, which always uses the room palette
+		_roomPalette = _vm->_roomPalette;
+		for (uint i = 0; i < _stripCache.size(); i++) {
+			int smapLen;
+			decompressCachedBitmap(nullptr, 0, findStrip(smap_ptr, i, smapLen), i, height);
+		}
+	}
+}
+
+/**
+ * Decode a strip of the room background to the cache if it isn't there
+ * yet, and copy it to @p dst. If @p dst is nullptr, the strip is only
+ * decoded.
+ */
+bool Gdi::decompressCachedBitmap(byte *dst, int dstPitch, const byte *src, int stripnr, int height) {
+	CachedStrip &strip = _stripCache[stripnr];
+
+	if (!strip.pixels && !strip.transparent) {
+		strip.pixels = (byte *)malloc(8 * height);
+		if (decompressBitmap(strip.pixels, 8, src, height)) {
+			free(strip.pixels);
+			strip.pixels = nullptr;
+			strip.transparent = true;
+		}
+	}
+
+	if (!dst)
+		return strip.transparent;
+
+	if (strip.transparent)
+		return decompressBitmap(dst, dstPitch, src, height);
+
+	const byte *pixels = strip.pixels;
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, pixels, 8);
+		dst += dstPitch;
+		pixels += 8;
+	}
+	return false;
+}
+
+bool Gdi::restoreCachedMask(int x, int y, int stripnr, int numzbuf, const byte *zplane_list[9], int height) {
+	if (stripnr < 0 || stripnr >= (int)_stripCache.size() || !_stripCache[stripnr].masks)
+		return false;
+
+	const byte *masks = _stripCache[stripnr].masks;
+	for (int i = 1; i < numzbuf; i++, masks += height) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			mask_ptr[h * _numStrips] = masks[h];
+	}
+	return true;
+}
+
+void Gdi::storeCachedMask(int x, int y, int stripnr, int numzbuf, const byte *zplane_list[9], int height) {
+	if (numzbuf <= 1 || stripnr < 0 || stripnr >= (int)_stripCache.size() || _stripCache[stripnr].masks)
+		return;
+
+	byte *masks = (byte *)malloc((numzbuf - 1) * height);
+	_stripCache[stripnr].masks = masks;
+	for (int i = 1; i < numzbuf; i++, masks += height) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			masks[h] = mask_ptr[h * _numStrips];
+	}
+}
+
 #ifdef ENABLE_HE
 /**
  * Draw a bitmap onto a virtual screen. This is main drawing method for room backgrounds
@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -310,6 +311,26 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * Decoded strips of the room background. Room images don't change while
+	 * the room is loaded, so redrawing the background (e.g. when scrolling)
+	 * only has to copy these, instead of running the strip codecs again.
+	 */
+	struct CachedStrip {
+		byte *pixels;     ///< 8 pixels per line, or nullptr if not decoded yet
+		byte *masks;      ///< One byte per line for each z-plane above 0, or nullptr if not decoded yet
+		bool transparent; ///< Transparent strips depend on what is below them, so they're never cached
+	};
+	Common::Array<CachedStrip> _stripCache;
+	const byte *_stripCacheImage;
+	int _stripCacheHeight;
+	int _stripCacheZPlanes;
+	byte _stripCachePalette[256];
+	/** Flag which is true while the room background is drawn, and the cache may be used. */
+	bool _stripCacheActive;
+	/** Flag which is true if the whole room should be decoded when it is first drawn. */
+	bool _stripCachePredecode;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -344,6 +365,18 @@ protected:
 
 	/* Misc */
 	int getZPlanes(const byte *smap_ptr, const byte *zplane_list[9], bool bmapImage) const;
+	const byte *findStrip(const byte *smap_ptr, int stripnr, int &smapLen) const;
+	uint32 getZPlaneOffset(const byte *zplane, int stripnr) const;
+	void applyRoomPaletteWorkaround(VirtScreen *vs, int smapLen);
+
+	/* Background strip cache */
+	void resetStripCache();
+	void prepareStripCache(const byte *ptr, const byte *smap_ptr, const byte *zplane_list[9], int numzbuf, int height);
+	bool decompressCachedBitmap(byte *dst, int dstPitch, const byte *src, int stripnr, int height);
+	bool restoreCachedMask(int x, int y, int stripnr, int numzbuf, const byte *zplane_list[9], int height);
+	void storeCachedMask(int x, int y, int stripnr, int numzbuf, const byte *zplane_list[9], int height);
+	/** Whether the background strips can be cached, i.e. they're decoded by drawStrip() and decodeMask() of this class. */
+	virtual bool canCacheStrips() const { return true; }
 
 	virtual bool drawStrip(byte *dstPtr, VirtScreen *vs,
 					int x, int y, const int width, const int height,
@@ -401,6 +434,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -433,6 +468,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -476,6 +513,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -515,6 +554,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -544,6 +585,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
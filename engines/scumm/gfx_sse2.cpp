@@ -0,0 +1,40 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+#include "scumm/scumm.h"
+
+namespace Scumm {
+
+int compositeTextSpanSSE2(byte *dst, const byte *src, const byte *text, int count) {
+	const __m128i trans = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+	int done = 0;
+	for (; done + 16 <= count; done += 16) {
+		__m128i textColor = _mm_loadu_si128((const __m128i *)(text + done));
+		__m128i srcColor = _mm_loadu_si128((const __m128i *)(src + done));
+		__m128i isTrans = _mm_cmpeq_epi8(textColor, trans);
+		__m128i result = _mm_or_si128(_mm_and_si128(isTrans, srcColor), _mm_andnot_si128(isTrans, textColor));
+		_mm_storeu_si128((__m128i *)(dst + done), result);
+	}
+	return done;
+}
+
+} // End of namespace Scumm
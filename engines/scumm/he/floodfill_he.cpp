@@ -286,6 +286,7 @@ void Wiz::fillWizFlood(const WizParameters *params) {
 		}
 	}
 	_vm->_res->setModified(rtImage, params->img.resNum);
+	invalidateWizCache(params->img.resNum);
 }
 
 } // End of namespace Scumm
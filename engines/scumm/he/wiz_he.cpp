@@ -34,12 +34,25 @@
 
 namespace Scumm {
 
+#ifdef SCUMMVM_SSE2
+bool Wiz::_hasSSE2 = false;
+#endif
+
 Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	_imagesNum = 0;
 	memset(&_images, 0, sizeof(_images));
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_wizCacheSize = 0;
+	_wizCacheCounter = 0;
+#ifdef SCUMMVM_SSE2
+	_hasSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
+}
+
+Wiz::~Wiz() {
+	clearWizCache();
 }
 
 void Wiz::clearWizBuffer() {
@@ -648,12 +661,20 @@ void Wiz::copyRaw16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int d
 		src += (r1.top * srcw + r1.left) * 2;
 		dst += r2.top * dstPitch + r2.left * 2;
 		while (h--) {
+#ifdef SCUMM_LITTLE_ENDIAN
+			if (transColor < 0 || transColor > 0xFFFF) {
+				memcpy(dst, src, w * 2);
+			} else {
+				copy16BitSpan(dst, src, w, transColor);
+			}
+#else
 			for (int i = 0; i < w; ++ i) {
 				uint16 col = READ_LE_UINT16(src + 2 * i);
 				if (transColor == -1 || transColor != col) {
 					writeColor(dst + i * 2, dstType, col);
 				}
 			}
+#endif
 			src += srcw * 2;
 			dst += dstPitch;
 		}
@@ -703,6 +724,50 @@ void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, cons
 	}
 }
 
+// The span helpers below expect both source and destination in little
+// endian order, which on little endian hosts holds for every dstType.
+void Wiz::shadow16BitSpan(uint8 *dst, const uint8 *src, int count) {
+#ifdef SCUMMVM_SSE2
+	if (_hasSSE2) {
+		int done = shadow16BitSpanSSE2(dst, src, count);
+		dst += done * 2;
+		src += done * 2;
+		count -= done;
+	}
+#endif
+	// Two pixels at a time: the mask also clears the bit shifted over
+	// from the neighbouring pixel, and the halves can't carry into each other.
+	for (; count >= 2; count -= 2) {
+		uint32 srcColor = (READ_LE_UINT32(src) >> 1) & 0x7DEF7DEF;
+		uint32 dstColor = (READ_LE_UINT32(dst) >> 1) & 0x7DEF7DEF;
+		WRITE_LE_UINT32(dst, srcColor + dstColor);
+		src += 4;
+		dst += 4;
+	}
+	if (count) {
+		uint16 srcColor = (READ_LE_UINT16(src) >> 1) & 0x7DEF;
+		uint16 dstColor = (READ_LE_UINT16(dst) >> 1) & 0x7DEF;
+		WRITE_LE_UINT16(dst, srcColor + dstColor);
+	}
+}
+
+void Wiz::copy16BitSpan(uint8 *dst, const uint8 *src, int count, uint16 transColor) {
+#ifdef SCUMMVM_SSE2
+	if (_hasSSE2) {
+		int done = copy16BitSpanSSE2(dst, src, count, transColor);
+		dst += done * 2;
+		src += done * 2;
+		count -= done;
+	}
+#endif
+	for (int i = 0; i < count; ++i) {
+		uint16 col = READ_LE_UINT16(src + 2 * i);
+		if (col != transColor) {
+			WRITE_LE_UINT16(dst + 2 * i, col);
+		}
+	}
+}
+
 template<int type>
 void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
 	const uint8 *dataPtr, *dataPtrNext;
@@ -792,6 +857,18 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
+#ifdef SCUMM_LITTLE_ENDIAN
+					if (dstInc == 2) {
+						if (type == kWizXMap) {
+							shadow16BitSpan(dstPtr, dataPtr, code);
+						} else {
+							memcpy(dstPtr, dataPtr, code * 2);
+						}
+						dataPtr += code * 2;
+						dstPtr += code * 2;
+						continue;
+					}
+#endif
 					while (code--) {
 						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
 						dataPtr += 2;
@@ -926,6 +1003,12 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
+					if (type == kWizCopy && dstInc == 1) {
+						memcpy(dstPtr, dataPtr, code);
+						dataPtr += code;
+						dstPtr += code;
+						continue;
+					}
 					while (code--) {
 						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
 						dataPtr++;
@@ -1411,6 +1494,7 @@ void Wiz::captureImage(uint8 *src, int srcPitch, int srcw, int srch, int resNum,
 		}
 	}
 	_vm->_res->setModified(rtImage, resNum);
+	invalidateWizCache(resNum);
 }
 
 void Wiz::displayWizImage(WizImage *pwi) {
@@ -1585,6 +1669,10 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			state, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel, xmapPtr, conditionBits);
 	}
 
+	if (dstType == kDstResource) {
+		invalidateWizCache(dstResNum);
+	}
+
 	if (!(flags & kWIFBlitToMemBuffer) && dstResNum == 0) {
 		Common::Rect rImage(x1, y1, x1 + width, y1 + height);
 		if (rImage.intersects(rScreen)) {
@@ -2004,7 +2092,6 @@ void Wiz::drawWizPolygon(int resNum, int state, int id, int flags, int shadow, i
 
 void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int flags, int shadow, int dstResNum, int palette) {
 	debug(7, "drawWizPolygonTransform(resNum %d, flags 0x%X, shadow %d dstResNum %d palette %d)", resNum, flags, shadow, dstResNum, palette);
-	const Common::Rect *r = NULL;
 	uint8 *srcWizBuf = NULL;
 	bool freeBuffer = true;
 
@@ -2016,7 +2103,7 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 				debug(7, "drawWizPolygonTransform() unhandled flag 0x800000");
 			}
 
-			srcWizBuf = drawWizImage(resNum, state, 0, 0, 0, 0, 0, shadow, 0, r, flags, 0, _vm->getHEPaletteSlot(palette), 0);
+			srcWizBuf = drawCachedWizImage(resNum, state, shadow, flags, _vm->getHEPaletteSlot(palette), freeBuffer);
 		} else {
 			assert(_vm->_bytesPerPixel == 1);
 			uint8 *dataPtr = _vm->getResourceAddress(rtImage, resNum);
@@ -2027,7 +2114,7 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 		}
 	} else {
 		if (getWizImageData(resNum, state, 0) != 0) {
-			srcWizBuf = drawWizImage(resNum, state, 0, 0, 0, 0, 0, shadow, 0, r, kWIFBlitToMemBuffer, 0, _vm->getHEPaletteSlot(palette), 0);
+			srcWizBuf = drawCachedWizImage(resNum, state, shadow, kWIFBlitToMemBuffer, _vm->getHEPaletteSlot(palette), freeBuffer);
 		} else {
 			uint8 *dataPtr = _vm->getResourceAddress(rtImage, resNum);
 			assert(dataPtr);
@@ -2067,6 +2154,10 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 	getWizImageDim(resNum, state, wizW, wizH);
 	drawWizPolygonImage(dst, srcWizBuf, 0, dstpitch, dstType, dstw, dsth, wizW, wizH, bound, wp, _vm->_bytesPerPixel);
 
+	if (dstResNum) {
+		invalidateWizCache(dstResNum);
+	}
+
 	if (flags & kWIFMarkBufferDirty) {
 		_vm->markRectAsDirty(kMainVirtScreen, bound);
 	} else {
@@ -2077,6 +2168,105 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 		free(srcWizBuf);
 }
 
+bool Wiz::isWizImageCacheable(int resNum, int state, int flags) {
+	// Palette side effects have to happen on every draw, and the remap
+	// table may be recomputed from the current palette
+	if (flags & (kWIFHasPalette | kWIFRemapPalette))
+		return false;
+	if (_cursorImage || _rectOverrideEnabled)
+		return false;
+
+	// Composite images are assembled from other images, which we don't track
+	if (getWizImageData(resNum, state, 0) == 4)
+		return false;
+
+	if (_vm->_game.id == GID_MOONBASE &&
+			((ScummEngine_v100he *)_vm)->_moonbase->isFOW(resNum, state, 0))
+		return false;
+
+	return true;
+}
+
+uint8 *Wiz::drawCachedWizImage(int resNum, int state, int shadow, int flags, const uint8 *palPtr, bool &freeBuffer) {
+	freeBuffer = true;
+	if (!isWizImageCacheable(resNum, state, flags))
+		return drawWizImage(resNum, state, 0, 0, 0, 0, 0, shadow, 0, NULL, flags, 0, palPtr, 0);
+
+	const uint8 *dataPtr = _vm->getResourceAddress(rtImage, resNum);
+	const int transColor = (_vm->VAR_WIZ_TCOLOR != 0xFF) ? _vm->VAR(_vm->VAR_WIZ_TCOLOR) : 5;
+	const uint32 palSize = palPtr ? 256 * _vm->_bytesPerPixel : 0;
+
+	for (uint i = 0; i < _wizCache.size(); i++) {
+		DecodedWizImage &img = _wizCache[i];
+		if (img.resNum == resNum && img.state == state && img.flags == flags && img.shadow == shadow &&
+				img.transColor == transColor && img.dataPtr == dataPtr && img.palPtr == palPtr &&
+				(palSize == 0 || memcmp(img.palette, palPtr, palSize) == 0)) {
+			img.lastUsed = ++_wizCacheCounter;
+			freeBuffer = false;
+			return img.pixels;
+		}
+	}
+
+	uint8 *pixels = drawWizImage(resNum, state, 0, 0, 0, 0, 0, shadow, 0, NULL, flags, 0, palPtr, 0);
+	if (!pixels)
+		return NULL;
+
+	int32 w, h;
+	getWizImageDim(resNum, state, w, h);
+	const uint32 size = w * h * _vm->_bytesPerPixel;
+	if (size > kWizCacheBudget / 4)
+		return pixels;
+
+	while (_wizCacheSize + size > kWizCacheBudget) {
+		uint oldest = 0;
+		for (uint i = 1; i < _wizCache.size(); i++) {
+			if (_wizCache[i].lastUsed < _wizCache[oldest].lastUsed)
+				oldest = i;
+		}
+		_wizCacheSize -= _wizCache[oldest].size;
+		free(_wizCache[oldest].pixels);
+		_wizCache.remove_at(oldest);
+	}
+
+	DecodedWizImage img;
+	img.resNum = resNum;
+	img.state = state;
+	img.flags = flags;
+	img.shadow = shadow;
+	img.transColor = transColor;
+	img.dataPtr = dataPtr;
+	img.palPtr = palPtr;
+	if (palSize)
+		memcpy(img.palette, palPtr, palSize);
+	img.pixels = pixels;
+	img.size = size;
+	img.lastUsed = ++_wizCacheCounter;
+	_wizCache.push_back(img);
+	_wizCacheSize += size;
+
+	freeBuffer = false;
+	return pixels;
+}
+
+void Wiz::invalidateWizCache(int resNum) {
+	for (uint i = 0; i < _wizCache.size();) {
+		if (_wizCache[i].resNum == resNum || _wizCache[i].shadow == resNum) {
+			_wizCacheSize -= _wizCache[i].size;
+			free(_wizCache[i].pixels);
+			_wizCache.remove_at(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void Wiz::clearWizCache() {
+	for (uint i = 0; i < _wizCache.size(); i++)
+		free(_wizCache[i].pixels);
+	_wizCache.clear();
+	_wizCacheSize = 0;
+}
+
 void Wiz::drawWizPolygonImage(uint8 *dst, const uint8 *src, const uint8 *mask, int dstpitch, int dstType, int dstw, int dsth, int wizW, int wizH, Common::Rect &bound, Common::Point *wp, uint8 bitDepth) {
 	int i, transColor = (_vm->VAR_WIZ_TCOLOR != 0xFF) ? _vm->VAR(_vm->VAR_WIZ_TCOLOR) : 5;
 
@@ -2380,6 +2570,7 @@ void Wiz::createWizEmptyImage(int resNum, int img_x, int img_y, int img_w, int i
 		WRITE_BE_UINT32(res_data, 8 + img_w * img_h * bitDepth); res_data += 4;
 	}
 	_vm->_res->setModified(rtImage, resNum);
+	invalidateWizCache(resNum);
 }
 
 void Wiz::fillWizRect(const WizParameters *params) {
@@ -2431,6 +2622,7 @@ void Wiz::fillWizRect(const WizParameters *params) {
 		}
 	}
 	_vm->_res->setModified(rtImage, params->img.resNum);
+	invalidateWizCache(params->img.resNum);
 }
 
 struct drawProcP {
@@ -2500,6 +2692,7 @@ void Wiz::fillWizLine(const WizParameters *params) {
 		}
 	}
 	_vm->_res->setModified(rtImage, params->img.resNum);
+	invalidateWizCache(params->img.resNum);
 }
 
 void Wiz::fillWizPixel(const WizParameters *params) {
@@ -2537,6 +2730,7 @@ void Wiz::fillWizPixel(const WizParameters *params) {
 		}
 	}
 	_vm->_res->setModified(rtImage, params->img.resNum);
+	invalidateWizCache(params->img.resNum);
 }
 
 void Wiz::remapWizImagePal(const WizParameters *params) {
@@ -2553,6 +2747,7 @@ void Wiz::remapWizImagePal(const WizParameters *params) {
 		rmap[4 + idx] = params->remapColor[idx];
 	}
 	_vm->_res->setModified(rtImage, params->img.resNum);
+	invalidateWizCache(params->img.resNum);
 }
 
 void Wiz::processWizImage(const WizParameters *params) {
@@ -2584,6 +2779,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 						_vm->VAR(119) = -2;
 					} else {
 						_vm->_res->setModified(rtImage, params->img.resNum);
+						invalidateWizCache(params->img.resNum);
 						_vm->VAR(_vm->VAR_GAME_LOADED) = 0;
 						_vm->VAR(119) = 0;
 					}
@@ -2693,6 +2889,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 		// Used in to draw circles in FreddisFunShop/PuttsFunShop/SamsFunShop
 		// TODO: Ellipse
 		_vm->_res->setModified(rtImage, params->img.resNum);
+		invalidateWizCache(params->img.resNum);
 		break;
 	default:
 		error("Unhandled processWizImage mode %d", params->processMode);
@@ -22,6 +22,7 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -244,6 +245,7 @@ public:
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -298,6 +300,9 @@ public:
 	void drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int flags, int shadow, int dstResNum, int palette);
 	void drawWizPolygonImage(uint8 *dst, const uint8 *src, const uint8 *mask, int dstpitch, int dstType, int dstw, int dsth, int wizW, int wizH, Common::Rect &bound, Common::Point *wp, uint8 bitDepth);
 
+	void invalidateWizCache(int resNum);
+	void clearWizCache();
+
 #ifdef USE_RGB_COLOR
 	static void copyMaskWizImage(uint8 *dst, const uint8 *src, const uint8 *mask, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr);
 
@@ -322,6 +327,14 @@ public:
 
 #ifdef USE_RGB_COLOR
 	template<int type> static void write16BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *xmapPtr);
+#endif
+#ifdef USE_RGB_COLOR
+	static void shadow16BitSpan(uint8 *dst, const uint8 *src, int count);
+	static void copy16BitSpan(uint8 *dst, const uint8 *src, int count, uint16 transColor);
+#ifdef SCUMMVM_SSE2
+	static int shadow16BitSpanSSE2(uint8 *dst, const uint8 *src, int count);
+	static int copy16BitSpanSSE2(uint8 *dst, const uint8 *src, int count, uint16 transColor);
+#endif
 #endif
 	template<int type> static void write8BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	static void writeColor(uint8 *dstPtr, int dstType, uint16 color);
@@ -333,6 +346,39 @@ public:
 
 private:
 	ScummEngine_v71he *_vm;
+
+	/**
+	 * Images decoded into memory buffers for polygon drawing, kept around
+	 * since the same sprites usually get rotated and scaled every frame.
+	 */
+	struct DecodedWizImage {
+		int resNum;
+		int state;
+		int flags;
+		int shadow;
+		int transColor;
+		const uint8 *dataPtr;
+		const uint8 *palPtr;
+		uint8 palette[512];
+		uint8 *pixels;
+		uint32 size;
+		uint32 lastUsed;
+	};
+
+	enum {
+		kWizCacheBudget = 4 * 1024 * 1024
+	};
+
+	Common::Array<DecodedWizImage> _wizCache;
+	uint32 _wizCacheSize;
+	uint32 _wizCacheCounter;
+
+	bool isWizImageCacheable(int resNum, int state, int flags);
+	uint8 *drawCachedWizImage(int resNum, int state, int shadow, int flags, const uint8 *palPtr, bool &freeBuffer);
+
+#ifdef SCUMMVM_SSE2
+	static bool _hasSSE2;
+#endif
 };
 
 } // End of namespace Scumm
@@ -0,0 +1,55 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+#include "scumm/he/wiz_he.h"
+
+namespace Scumm {
+
+#ifdef USE_RGB_COLOR
+int Wiz::shadow16BitSpanSSE2(uint8 *dst, const uint8 *src, int count) {
+	const __m128i mask = _mm_set1_epi16(0x7DEF);
+	int done = 0;
+	for (; done + 8 <= count; done += 8) {
+		__m128i srcColor = _mm_loadu_si128((const __m128i *)(src + done * 2));
+		__m128i dstColor = _mm_loadu_si128((const __m128i *)(dst + done * 2));
+		srcColor = _mm_and_si128(_mm_srli_epi16(srcColor, 1), mask);
+		dstColor = _mm_and_si128(_mm_srli_epi16(dstColor, 1), mask);
+		_mm_storeu_si128((__m128i *)(dst + done * 2), _mm_add_epi16(srcColor, dstColor));
+	}
+	return done;
+}
+
+int Wiz::copy16BitSpanSSE2(uint8 *dst, const uint8 *src, int count, uint16 transColor) {
+	const __m128i trans = _mm_set1_epi16((short)transColor);
+	int done = 0;
+	for (; done + 8 <= count; done += 8) {
+		__m128i srcColor = _mm_loadu_si128((const __m128i *)(src + done * 2));
+		__m128i dstColor = _mm_loadu_si128((const __m128i *)(dst + done * 2));
+		__m128i isTrans = _mm_cmpeq_epi16(srcColor, trans);
+		__m128i result = _mm_or_si128(_mm_and_si128(isTrans, dstColor), _mm_andnot_si128(isTrans, srcColor));
+		_mm_storeu_si128((__m128i *)(dst + done * 2), result);
+	}
+	return done;
+}
+#endif
+
+} // End of namespace Scumm
@@ -36,14 +36,24 @@ BundleDirCache::BundleDirCache(const ScummEngine *vm) : _vm(vm) {
 		_bundleDirCache[fileId].numFiles = 0;
 		_bundleDirCache[fileId].isCompressed = false;
 		_bundleDirCache[fileId].indexTable = nullptr;
+		_bundleDirCache[fileId].readAheadFile = nullptr;
 	}
+
+	_blockCache = nullptr;
+	_blockCacheCounter = 0;
+	_blockHits = 0;
+	_blockMisses = 0;
+	_blockReadAhead = 0;
+	_readAheadCount = 0;
 }
 
 BundleDirCache::~BundleDirCache() {
 	for (int fileId = 0; fileId < ARRAYSIZE(_bundleDirCache); fileId++) {
 		free(_bundleDirCache[fileId].bundleTable);
 		free(_bundleDirCache[fileId].indexTable);
+		delete _bundleDirCache[fileId].readAheadFile;
 	}
+	free(_blockCache);
 }
 
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
@@ -131,12 +141,152 @@ int BundleDirCache::matchFile(const char *filename) {
 		}
 		qsort(_bundleDirCache[freeSlot].indexTable, _bundleDirCache[freeSlot].numFiles,
 				sizeof(IndexNode), (int (*)(const void *, const void *))scumm_stricmp);
+
+		// The read-ahead worker gets a handle of its own, so that it never
+		// disturbs the file position of the BundleMgr instances
+		BaseScummFile *readAheadFile = new ScummFile(_vm);
+		if (!g_scumm->openFile(*readAheadFile, filename)) {
+			delete readAheadFile;
+			readAheadFile = nullptr;
+		}
+
+		// The read-ahead timer proc picks up the handle from another thread
+		Common::StackLock lock(_blockCacheMutex);
+		_bundleDirCache[freeSlot].readAheadFile = readAheadFile;
 		return freeSlot;
 	} else {
 		return fileId;
 	}
 }
 
+BundleDirCache::BlockCacheEntry *BundleDirCache::findBlock(int slot, int32 index, int32 block) {
+	if (!_blockCache)
+		return nullptr;
+
+	for (int i = 0; i < kBlockCacheSize; i++) {
+		BlockCacheEntry &entry = _blockCache[i];
+		if (entry.size > 0 && entry.block == block && entry.index == index && entry.slot == slot)
+			return &entry;
+	}
+	return nullptr;
+}
+
+bool BundleDirCache::getBlock(int slot, int32 index, int32 block, byte *dst, int32 &size) {
+	Common::StackLock lock(_blockCacheMutex);
+
+	BlockCacheEntry *entry = findBlock(slot, index, block);
+	if (!entry) {
+		_blockMisses++;
+		return false;
+	}
+
+	_blockHits++;
+	entry->lastUsed = ++_blockCacheCounter;
+	memcpy(dst, entry->data, entry->size);
+	size = entry->size;
+	return true;
+}
+
+void BundleDirCache::storeBlock(int slot, int32 index, int32 block, const byte *src, int32 size) {
+	if (size <= 0 || size > DIMUSE_BUN_CHUNK_SIZE)
+		return;
+
+	Common::StackLock lock(_blockCacheMutex);
+
+	if (!_blockCache) {
+		_blockCache = (BlockCacheEntry *)calloc(kBlockCacheSize, sizeof(BlockCacheEntry));
+		assert(_blockCache);
+	}
+
+	BlockCacheEntry *entry = findBlock(slot, index, block);
+	if (!entry) {
+		// Replace the least recently used block; empty entries come first
+		entry = &_blockCache[0];
+		for (int i = 1; i < kBlockCacheSize && entry->size > 0; i++) {
+			if (_blockCache[i].size == 0 || _blockCache[i].lastUsed < entry->lastUsed)
+				entry = &_blockCache[i];
+		}
+	}
+
+	entry->slot = slot;
+	entry->index = index;
+	entry->block = block;
+	entry->size = size;
+	entry->lastUsed = ++_blockCacheCounter;
+	memcpy(entry->data, src, size);
+}
+
+void BundleDirCache::queueReadAhead(const ReadAheadRequest &request) {
+	Common::StackLock lock(_blockCacheMutex);
+
+	if (_readAheadCount == kReadAheadQueueSize || !_bundleDirCache[request.slot].readAheadFile)
+		return;
+	if (findBlock(request.slot, request.index, request.block))
+		return;
+
+	for (int i = 0; i < _readAheadCount; i++) {
+		const ReadAheadRequest &queued = _readAheadQueue[i];
+		if (queued.slot == request.slot && queued.index == request.index && queued.block == request.block)
+			return;
+	}
+
+	_readAheadQueue[_readAheadCount++] = request;
+}
+
+void BundleDirCache::processReadAhead() {
+	// This runs on the timer thread, which also runs the iMUSE callback, so
+	// only a single block is read and decoded per call to keep it short
+	ReadAheadRequest request;
+	BaseScummFile *file;
+	{
+		Common::StackLock lock(_blockCacheMutex);
+		do {
+			if (_readAheadCount == 0)
+				return;
+
+			request = _readAheadQueue[0];
+			_readAheadCount--;
+			memmove(_readAheadQueue, _readAheadQueue + 1, _readAheadCount * sizeof(ReadAheadRequest));
+		} while (findBlock(request.slot, request.index, request.block));
+
+		file = _bundleDirCache[request.slot].readAheadFile;
+	}
+
+	// CMI hack: one more zero byte at the end of input buffer
+	byte *input = (byte *)malloc(request.size + 1);
+	assert(input);
+	input[request.size] = 0;
+
+	// Only this worker ever touches the read-ahead file handles
+	byte output[DIMUSE_BUN_CHUNK_SIZE];
+	file->seek(request.offset, SEEK_SET);
+	int32 outputSize = 0;
+	if (file->read(input, request.size) == (uint32)request.size)
+		outputSize = BundleCodecs::decompressCodec(request.codec, input, output, request.size);
+	free(input);
+
+	if (outputSize > 0 && outputSize <= DIMUSE_BUN_CHUNK_SIZE) {
+		storeBlock(request.slot, request.index, request.block, output, outputSize);
+		Common::StackLock lock(_blockCacheMutex);
+		_blockReadAhead++;
+	}
+}
+
+void BundleDirCache::getBlockCacheStats(uint32 &hits, uint32 &misses, uint32 &readAhead, int &used) {
+	Common::StackLock lock(_blockCacheMutex);
+
+	hits = _blockHits;
+	misses = _blockMisses;
+	readAhead = _blockReadAhead;
+	used = 0;
+	if (_blockCache) {
+		for (int i = 0; i < kBlockCacheSize; i++) {
+			if (_blockCache[i].size > 0)
+				used++;
+		}
+	}
+}
+
 BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
 	_cache = cache;
 	_bundleTable = nullptr;
@@ -146,6 +296,7 @@ BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
 	_lastBlockDecompressedSize = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_dirCacheSlot = -1;
 	_file = new ScummFile(vm);
 	_compInputBuff = nullptr;
 }
@@ -185,6 +336,7 @@ bool BundleMgr::open(const char *filename, bool &isCompressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_dirCacheSlot = slot;
 	isCompressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -350,14 +502,20 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 
 		for (i = firstBlock; i <= lastBlock; i++) {
 			if (_lastBlock != i) {
-				// CMI hack: one more zero byte at the end of input buffer
-				_compInputBuff[_compTable[i].size] = 0;
-				_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
-				_file->read(_compInputBuff, _compTable[i].size);
-				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-
-				if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
-					error("_outputSize: %d", _outputSize);
+				int32 cachedSize;
+				if (_cache->getBlock(_dirCacheSlot, found->index, i, _compOutputBuff, cachedSize)) {
+					_outputSize = cachedSize;
+				} else {
+					// CMI hack: one more zero byte at the end of input buffer
+					_compInputBuff[_compTable[i].size] = 0;
+					_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
+					_file->read(_compInputBuff, _compTable[i].size);
+					_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+
+					if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
+						error("_outputSize: %d", _outputSize);
+					}
+					_cache->storeBlock(_dirCacheSlot, found->index, i, _compOutputBuff, _outputSize);
 				}
 				_lastBlock = i;
 			}
@@ -391,6 +549,18 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		}
 		_curDecompressedFilePos += finalSize;
 
+		// Have the following blocks decoded before the streamer asks for them
+		for (i = lastBlock + 1; i <= lastBlock + kReadAheadBlocks && i < _numCompItems; i++) {
+			BundleDirCache::ReadAheadRequest request;
+			request.slot = _dirCacheSlot;
+			request.index = found->index;
+			request.block = i;
+			request.offset = _bundleTable[found->index].offset + _compTable[i].offset;
+			request.size = _compTable[i].size;
+			request.codec = _compTable[i].codec;
+			_cache->queueReadAhead(request);
+		}
+
 		return finalSize;
 	}
 
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/mutex.h"
 #include "scumm/imuse_digi/dimuse_defs.h"
 
 namespace Scumm {
@@ -43,6 +44,15 @@ public:
 		int32 index;
 	};
 
+	struct ReadAheadRequest {
+		int slot;
+		int32 index;
+		int32 block;
+		int32 offset;
+		int32 size;
+		int32 codec;
+	};
+
 private:
 
 	struct FileDirCache {
@@ -51,9 +61,39 @@ private:
 		int32 numFiles;
 		bool isCompressed;
 		IndexNode *indexTable;
+		BaseScummFile *readAheadFile;
 	} _bundleDirCache[4];
 
 	const ScummEngine *_vm;
+
+	// Decompressed blocks, shared between all the BundleMgr instances
+	// since every sound gets its own instance
+	enum {
+		kBlockCacheSize = 256,
+		kReadAheadQueueSize = 16
+	};
+
+	struct BlockCacheEntry {
+		int slot;
+		int32 index;
+		int32 block;
+		int32 size;
+		uint32 lastUsed;
+		byte data[DIMUSE_BUN_CHUNK_SIZE];
+	};
+
+	BlockCacheEntry *_blockCache;
+	uint32 _blockCacheCounter;
+	uint32 _blockHits;
+	uint32 _blockMisses;
+	uint32 _blockReadAhead;
+
+	ReadAheadRequest _readAheadQueue[kReadAheadQueueSize];
+	int _readAheadCount;
+	Common::Mutex _blockCacheMutex;
+
+	BlockCacheEntry *findBlock(int slot, int32 index, int32 block);
+
 public:
 	BundleDirCache(const ScummEngine *vm);
 	~BundleDirCache();
@@ -63,11 +103,21 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	bool getBlock(int slot, int32 index, int32 block, byte *dst, int32 &size);
+	void storeBlock(int slot, int32 index, int32 block, const byte *src, int32 size);
+	void queueReadAhead(const ReadAheadRequest &request);
+	void processReadAhead();
+	void getBlockCacheStats(uint32 &hits, uint32 &misses, uint32 &readAhead, int &used);
 };
 
 class BundleMgr {
 
 private:
+	enum {
+		kReadAheadBlocks = 2
+	};
+
 	struct CompTable {
 		int32 offset;
 		int32 size;
@@ -92,6 +142,7 @@ private:
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
+	int _dirCacheSlot;
 	bool loadCompTable(int32 index);
 
 public:
@@ -1119,4 +1119,18 @@ void IMuseDigital::listGroups() {
 	_vm->getDebugger()->debugPrintf("\tMUSICEFF: %3d\n\n", _groupsHandler->getGroupVol(DIMUSE_GROUP_MUSICEFF));
 }
 
+void IMuseDigital::listBundleCache() {
+	uint32 hits, misses, readAhead;
+	int used;
+	_filesHandler->getBundleDirCache()->getBlockCacheStats(hits, misses, readAhead, used);
+
+	uint32 total = hits + misses;
+	_vm->getDebugger()->debugPrintf("Bundle block cache:\n");
+	_vm->getDebugger()->debugPrintf("\tBlocks cached:      %d\n", used);
+	_vm->getDebugger()->debugPrintf("\tHits:               %u\n", hits);
+	_vm->getDebugger()->debugPrintf("\tMisses:             %u\n", misses);
+	_vm->getDebugger()->debugPrintf("\tHit rate:           %.1f%%\n", total ? hits * 100.0 / total : 0.0);
+	_vm->getDebugger()->debugPrintf("\tDecoded read-ahead: %u\n\n", readAhead);
+}
+
 } // End of namespace Scumm
@@ -67,6 +67,7 @@ public:
 	int setCurrentSpeechFilename(const char *fileName);
 	void setCurrentFtSpeechFile(const char *fileName, ScummFile *file, uint32 offset, uint32 size);
 	void closeSoundImmediatelyById(int soundId);
+	BundleDirCache *getBundleDirCache() { return _sound->getBundleDirCache(); }
 	void saveLoad(Common::Serializer &ser);
 };
 
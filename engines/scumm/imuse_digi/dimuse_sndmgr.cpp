@@ -21,6 +21,7 @@
 
 
 #include "common/scummsys.h"
+#include "common/timer.h"
 
 #include "audio/audiostream.h"
 #include "audio/decoders/flac.h"
@@ -36,6 +37,11 @@
 
 namespace Scumm {
 
+void ImuseDigiSndMgr::readAheadHandler(void *refCon) {
+	BundleDirCache *cache = (BundleDirCache *)refCon;
+	cache->processReadAhead();
+}
+
 ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	for (int l = 0; l < MAX_IMUSE_SOUNDS; l++) {
 		memset(&_sounds[l], 0, sizeof(SoundDesc));
@@ -45,9 +51,15 @@ ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	_cacheBundleDir = new BundleDirCache(scumm);
 	assert(_cacheBundleDir);
 	BundleCodecs::initializeImcTables();
+
+	// Decodes one upcoming bundle block per call, in between the iMUSE
+	// callbacks which run on the same timer thread
+	_vm->getTimerManager()->installTimerProc(readAheadHandler, 1000000 / 100, _cacheBundleDir, "BundleReadAhead");
 }
 
 ImuseDigiSndMgr::~ImuseDigiSndMgr() {
+	_vm->getTimerManager()->removeTimerProc(readAheadHandler);
+
 	for (int l = 0; l < MAX_IMUSE_SOUNDS; l++) {
 		closeSound(&_sounds[l]);
 	}
@@ -78,6 +78,8 @@ private:
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
 
+	static void readAheadHandler(void *refCon);
+
 public:
 
 	ImuseDigiSndMgr(ScummEngine *scumm);
@@ -89,6 +91,7 @@ public:
 	SoundDesc *findSoundById(int soundId);
 	SoundDesc *getSounds();
 	void scheduleSoundForDeallocation(int soundId);
+	BundleDirCache *getBundleDirCache() { return _cacheBundleDir; }
 
 };
 
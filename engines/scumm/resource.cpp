@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/md5.h"
 #include "common/str.h"
 #include "common/memstream.h"
@@ -49,6 +50,7 @@ enum {
 	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
+	RS_EXPIRED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
@@ -779,7 +781,7 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return nullptr;
 	}
 
-	_res->setResourceCounter(type, idx, 1);
+	_res->markResourceUsed(type, idx);
 
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, (void *)ptr);
 	return ptr;
@@ -823,6 +825,19 @@ void ResourceManager::increaseResourceCounters() {
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
 	_types[type][idx].setResourceCounter(counter);
+
+	// Scripts use the maximum count to mark resources they are done with
+	if (counter == RF_USAGE_MAX)
+		_types[type][idx]._roomGeneration = 0;
+}
+
+void ResourceManager::markResourceUsed(ResType type, ResId idx) {
+	_types[type][idx].setResourceCounter(1);
+	_types[type][idx]._roomGeneration = _roomGeneration;
+}
+
+void ResourceManager::beginRoom() {
+	_roomGeneration++;
 }
 
 void ResourceManager::Resource::setResourceCounter(byte counter) {
@@ -867,9 +882,19 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	_allocatedSize += size;
 
-	_types[type][idx]._address = ptr;
-	_types[type][idx]._size = size;
-	setResourceCounter(type, idx, 1);
+	Resource &res = _types[type][idx];
+	if (_types[type]._mode != kDynamicResTypeMode) {
+		_numLoads++;
+		if (res.isExpired()) {
+			res.setExpired(false);
+			_numReloads++;
+			_reloadedSize += size;
+		}
+	}
+
+	res._address = ptr;
+	res._size = size;
+	markResourceUsed(type, idx);
 
 	_vm->_insideCreateResource--;
 
@@ -883,6 +908,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_roomGeneration = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -911,6 +937,12 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_roomGeneration = 1;
+	_numLoads = 0;
+	_numReloads = 0;
+	_reloadedSize = 0;
+	_numExpired = 0;
+	_expiredSize = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -996,6 +1028,17 @@ bool ResourceManager::Resource::isLocked() const {
 	return (_flags & RF_LOCK) != 0;
 }
 
+void ResourceManager::Resource::setExpired(bool expired) {
+	if (expired)
+		_status |= RS_EXPIRED;
+	else
+		_status &= ~RS_EXPIRED;
+}
+
+bool ResourceManager::Resource::isExpired() const {
+	return (_status & RS_EXPIRED) != 0;
+}
+
 bool ScummEngine::isResourceInUse(ResType type, ResId idx) const {
 	if (!_res->validateResource("isResourceInUse", type, idx))
 		return false;
@@ -1077,10 +1120,31 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+namespace {
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	byte counter;
+	bool currentRoom;
+	uint32 size;
+};
+
+// Resources from earlier rooms go first, then the least recently used ones,
+// and among those the biggest, so that as few as possible have to be reloaded
+struct ExpireOrder {
+	bool operator()(const ExpireCandidate &a, const ExpireCandidate &b) const {
+		if (a.currentRoom != b.currentRoom)
+			return !a.currentRoom;
+		if (a.counter != b.counter)
+			return a.counter > b.counter;
+		return a.size > b.size;
+	}
+};
+
+} // End of anonymous namespace
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1093,31 +1157,42 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
+	// Collect all candidates in a single pass, rather than rescanning every
+	// resource for each one that gets expired
+	Common::Array<ExpireCandidate> candidates;
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._mode != kDynamicResTypeMode) {
+			// Resources of this type can be reloaded from the data files,
+			// so we can potentially unload them to free memory.
+			ResId idx = _types[type].size();
+			while (idx-- > 0) {
+				Resource &tmp = _types[type][idx];
+				byte counter = tmp.getResourceCounter();
+				if (!tmp.isLocked() && counter >= 2 && tmp._address && !tmp.isOffHeap() && !_vm->isResourceInUse(type, idx)) {
+					ExpireCandidate candidate;
+					candidate.type = type;
+					candidate.idx = idx;
+					candidate.counter = counter;
+					candidate.currentRoom = (tmp._roomGeneration == _roomGeneration);
+					candidate.size = tmp._size;
+					candidates.push_back(candidate);
 				}
 			}
 		}
+	}
 
-		if (!best_type)
+	Common::sort(candidates.begin(), candidates.end(), ExpireOrder());
+
+	for (uint i = 0; i < candidates.size(); i++) {
+		Resource &tmp = _types[candidates[i].type][candidates[i].idx];
+		_numExpired++;
+		_expiredSize += tmp._size;
+		nukeResource(candidates[i].type, candidates[i].idx);
+		tmp.setExpired(true);
+
+		if (size + _allocatedSize <= _minHeapThreshold)
 			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	}
 
 	increaseResourceCounters();
 
@@ -1201,6 +1276,8 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug(1, "Heap threshold=%d..%d, loads=%d, expired=%d(%d), reloads=%d(%d)",
+		_minHeapThreshold, _maxHeapThreshold, _numLoads, _numExpired, _expiredSize, _numReloads, _reloadedSize);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
@@ -104,8 +104,9 @@ public:
 		byte _flags;
 
 		/**
-		 * The status of the resource. Currently only one bit is used, which
-		 * indicates whether the resource is modified.
+		 * The status of the resource: whether it is modified, and whether it
+		 * was expired to make room for others (which makes loading it again
+		 * count as a reload in the statistics).
 		 */
 		byte _status;
 
@@ -125,6 +126,13 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * The room generation (see ResourceManager::beginRoom) in which the
+		 * resource was last used. Resources used in the current room are
+		 * only expired once nothing else can be freed.
+		 */
+		uint32 _roomGeneration;
+
 	public:
 		Resource();
 		~Resource();
@@ -138,6 +146,9 @@ public:
 		void unlock();
 		bool isLocked() const;
 
+		void setExpired(bool expired);
+		bool isExpired() const;
+
 		// HE specific
 		void setModified();
 		bool isModified() const;
@@ -174,6 +185,11 @@ protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _roomGeneration;
+
+	// Statistics, see resourceStats()
+	uint32 _numLoads, _numReloads, _reloadedSize;
+	uint32 _numExpired, _expiredSize;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -216,6 +232,19 @@ public:
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
+	/**
+	 * Reset the specified resource's counter and mark it as used in the
+	 * current room.
+	 */
+	void markResourceUsed(ResType type, ResId idx);
+
+	/**
+	 * Start a new room generation. This is invoked by ScummEngine::startScene,
+	 * so that the resources used in the previous room are the first to go
+	 * when memory runs low.
+	 */
+	void beginRoom();
+
 	/**
 	 * Increment the counter of all unlocked loaded resources.
 	 * The maximal count is 255.
@@ -131,6 +131,7 @@ void ScummEngine::startScene(int room, Actor *a, int objectNr) {
 	_fullRedraw = true;
 
 	_res->increaseResourceCounters();
+	_res->beginRoom();
 
 	_currentRoom = room;
 	VAR(VAR_ROOM) = room;
@@ -520,6 +521,7 @@ void ScummEngine::resetRoomSubBlocks() {
 
 	_res->nukeResource(rtMatrix, 1);
 	_res->nukeResource(rtMatrix, 2);
+	invalidateBoxCache();
 	if (_game.features & GF_SMALL_HEADER) {
 		ptr = findResourceData(MKTAG('B','O','X','D'), roomptr);
 		if (ptr) {
@@ -530,13 +532,13 @@ void ScummEngine::resetRoomSubBlocks() {
 			else
 				size = numOfBoxes * SIZEOF_BOX + 1;
 
-			_res->createResource(rtMatrix, 2, size);
+			createBoxResource(2, size);
 			memcpy(getResourceAddress(rtMatrix, 2), ptr, size);
 			ptr += size;
 
 			size = getResourceDataSize(ptr - size - _resourceHeaderSize) - size;
 			if (size > 0) {					// do this :)
-				_res->createResource(rtMatrix, 1, size);
+				createBoxResource(1, size);
 				memcpy(getResourceAddress(rtMatrix, 1), ptr, size);
 			}
 
@@ -545,7 +547,7 @@ void ScummEngine::resetRoomSubBlocks() {
 		ptr = findResourceData(MKTAG('B','O','X','D'), roomptr);
 		if (ptr) {
 			int size = getResourceDataSize(ptr);
-			_res->createResource(rtMatrix, 2, size);
+			createBoxResource(2, size);
 			roomptr = getResourceAddress(rtRoom, _roomResource);
 			ptr = findResourceData(MKTAG('B','O','X','D'), roomptr);
 			memcpy(getResourceAddress(rtMatrix, 2), ptr, size);
@@ -554,7 +556,7 @@ void ScummEngine::resetRoomSubBlocks() {
 		ptr = findResourceData(MKTAG('B','O','X','M'), roomptr);
 		if (ptr) {
 			int size = getResourceDataSize(ptr);
-			_res->createResource(rtMatrix, 1, size);
+			createBoxResource(1, size);
 			roomptr = getResourceAddress(rtRoom, _roomResource);
 			ptr = findResourceData(MKTAG('B','O','X','M'), roomptr);
 			memcpy(getResourceAddress(rtMatrix, 1), ptr, size);
@@ -778,6 +780,7 @@ void ScummEngine_v3old::resetRoomSubBlocks() {
 	//
 	_res->nukeResource(rtMatrix, 1);
 	_res->nukeResource(rtMatrix, 2);
+	invalidateBoxCache();
 
 	if (_game.version <= 2)
 		ptr = roomptr + *(roomptr + 0x15);
@@ -797,7 +800,7 @@ void ScummEngine_v3old::resetRoomSubBlocks() {
 			ptr = roomptr + *(roomptr + 0x15);
 			size = numOfBoxes * SIZEOF_BOX_V0 + 1;
 
-			_res->createResource(rtMatrix, 2, size + 1);
+			createBoxResource(2, size + 1);
 			getResourceAddress(rtMatrix, 2)[0] = numOfBoxes;
 			memcpy(getResourceAddress(rtMatrix, 2) + 1, ptr, size);
 		} else {
@@ -807,7 +810,7 @@ void ScummEngine_v3old::resetRoomSubBlocks() {
 			else
 				size = numOfBoxes * SIZEOF_BOX_V3 + 1;
 
-			_res->createResource(rtMatrix, 2, size);
+			createBoxResource(2, size);
 			memcpy(getResourceAddress(rtMatrix, 2), ptr, size);
 		}
 
@@ -833,7 +836,7 @@ void ScummEngine_v3old::resetRoomSubBlocks() {
 		}
 
 		if (size > 0) {					// do this :)
-			_res->createResource(rtMatrix, 1, size);
+			createBoxResource(1, size);
 			memcpy(getResourceAddress(rtMatrix, 1), ptr, size);
 		}
 
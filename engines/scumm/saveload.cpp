@@ -1808,6 +1808,10 @@ void ScummEngine::saveLoadWithSerializer(Common::Serializer &s) {
 			}
 	}
 
+	// The walkboxes of the current room came with the resources
+	if (s.isLoading())
+		invalidateBoxCache();
+
 
 	//
 	// Save/load global object state
@@ -2258,6 +2262,9 @@ void ScummEngine_v71he::saveLoadWithSerializer(Common::Serializer &s) {
 	ScummEngine_v70he::saveLoadWithSerializer(s);
 
 	s.syncArray(_wiz->_polygons, ARRAYSIZE(_wiz->_polygons), syncWithSerializer);
+
+	if (s.isLoading())
+		_wiz->clearWizCache();
 }
 
 void syncWithSerializer(Common::Serializer &s, FloodFillParameters &ffp) {
@@ -3443,7 +3443,7 @@ void ScummEngine_v6::o6_setBoxSet() {
 		error("ScummEngine_v6::o6_setBoxSet: Can't find dboxes for set %d", arg);
 
 	dboxSize = READ_BE_UINT32(boxd + 4) - 8;
-	byte *matrix = _res->createResource(rtMatrix, 2, dboxSize);
+	byte *matrix = createBoxResource(2, dboxSize);
 
 	assert(matrix);
 	memcpy(matrix, boxd + 8, dboxSize);
@@ -3456,7 +3456,7 @@ void ScummEngine_v6::o6_setBoxSet() {
 		error("ScummEngine_v6::o6_setBoxSet: Can't find mboxes for set %d", arg);
 
 	mboxSize = READ_BE_UINT32(boxm + 4) - 8;
-	matrix = _res->createResource(rtMatrix, 1, mboxSize);
+	matrix = createBoxResource(1, mboxSize);
 
 	assert(matrix);
 	memcpy(matrix, boxm + 8, mboxSize);
@@ -388,6 +388,9 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 		_compositeBuf = (byte *)malloc(_screenWidth * _screenHeight * sizeMult);
 	else
 		_compositeBuf = nullptr;
+#ifdef SCUMMVM_SSE2
+	_hasSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 
 	if (_renderMode == Common::kRenderHercA || _renderMode == Common::kRenderHercG)
 		_hercCGAScaleBuf = (byte *)malloc(kHercWidth * kHercHeight);
@@ -429,6 +432,9 @@ ScummEngine::~ScummEngine() {
 
 	delete[] _sortedActors;
 
+	free(_boxCoordsCache);
+	free(_nextBoxTable);
+
 	delete[] _languageBuffer;
 	delete[] _translatedLines;
 	delete[] _languageLineIndex;
@@ -1526,9 +1532,8 @@ void ScummEngine::setupScumm(const Common::Path &macResourceFile) {
 		}
 	}
 
+	int minHeapThreshold, maxHeapThreshold;
 #ifndef ATARI
-	int maxHeapThreshold = -1;
-
 	if (_game.features & GF_16BIT_COLOR) {
 		// 16bit color games require double the memory, due to increased resource sizes.
 		maxHeapThreshold = 12 * 1024 * 1024;
@@ -1539,13 +1544,37 @@ void ScummEngine::setupScumm(const Common::Path &macResourceFile) {
 	} else {
 		maxHeapThreshold = 550000;
 	}
-
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	minHeapThreshold = 400000;
 #else
 	// RAM is cheap, disk I/O isn't... helps with retaining the resources in COMI and similar
-	_res->setHeapThreshold(16 * 1024 * 1024, 32 * 1024 * 1024);
+	minHeapThreshold = 16 * 1024 * 1024;
+	maxHeapThreshold = 32 * 1024 * 1024;
 #endif
 
+	// Ports may register a default heap size (in KB) matching the memory
+	// they have available, and users can override it per game
+	// Parse the value here rather than with getInt(), which errors out on
+	// malformed values, and keep it in a range which cannot overflow
+	const Common::String heapSize = ConfMan.get("resource_heap_size");
+	if (!heapSize.empty()) {
+		char *end;
+		long heapSizeKB = strtol(heapSize.c_str(), &end, 10);
+		if (*end != '\0') {
+			warning("Ignoring invalid resource_heap_size value '%s'", heapSize.c_str());
+		} else if (heapSizeKB > 0) {
+			const long kMinHeapSizeKB = 256;
+			const long kMaxHeapSizeKB = 1024 * 1024;
+			if (heapSizeKB < kMinHeapSizeKB || heapSizeKB > kMaxHeapSizeKB) {
+				warning("resource_heap_size %ld is out of range, using %ld KB", heapSizeKB, CLIP(heapSizeKB, kMinHeapSizeKB, kMaxHeapSizeKB));
+				heapSizeKB = CLIP(heapSizeKB, kMinHeapSizeKB, kMaxHeapSizeKB);
+			}
+			maxHeapThreshold = (int)heapSizeKB * 1024;
+			minHeapThreshold = maxHeapThreshold / 4 * 3;
+		}
+	}
+
+	_res->setHeapThreshold(minHeapThreshold, maxHeapThreshold);
+
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
 }
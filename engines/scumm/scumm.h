@@ -1407,6 +1407,9 @@ public:
 protected:
 	// Screen rendering
 	byte *_compositeBuf;
+#ifdef SCUMMVM_SSE2
+	bool _hasSSE2 = false;
+#endif
 	byte *_hercCGAScaleBuf = nullptr;
 	bool _enableEGADithering = false;
 	bool _supportsEGADithering = false;
@@ -1550,6 +1553,8 @@ public:
 	bool checkXYInBoxBounds(int box, int x, int y);
 
 	BoxCoords getBoxCoordinates(int boxnum);
+	void invalidateBoxCache();
+	byte *createBoxResource(ResId idx, uint32 size);
 
 	byte getMaskFromBox(int box);
 	Box *getBoxBaseAddr(int box);
@@ -1575,6 +1580,16 @@ protected:
 	void createBoxMatrix();
 	virtual bool areBoxesNeighbors(int i, int j);
 
+	// The walkbox coordinates and the box matrix of the current room are
+	// decoded on first use, since actors query them for every walk step.
+	// Both are dropped whenever the room's box data is replaced.
+	BoxCoords readBoxCoordinates(int boxnum);
+	void buildNextBoxTable(int numOfBoxes);
+	BoxCoords *_boxCoordsCache = nullptr;
+	int8 *_nextBoxTable = nullptr;
+	int _numCachedBoxCoords = -1;
+	int _numNextBoxTableBoxes = -1;
+
 	/* String class */
 public:
 	CharsetRenderer *_charset = nullptr;
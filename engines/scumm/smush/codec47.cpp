@@ -69,6 +69,11 @@ namespace Scumm {
 		(dst)[1] = val;         \
 	} while (0)
 
+// Whole 8 pixel rows are moved at once; the compilers turn these into
+// single 64-bit loads and stores where the target allows unaligned access
+#define COPY_8X1_LINE(dst, src) memcpy((dst), (src), 8)
+#define FILL_8X1_LINE(dst, val) memset((dst), (val), 8)
+
 #define MOTION_OFFSET_TABLE_SIZE 0xF8
 #define PROCESS_SUBBLOCKS        0xFF
 #define FILL_SINGLE_COLOR        0xFE
@@ -162,12 +167,13 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 	int32 tableSmallBig[64], s;
 	const int8 *xGlyph = nullptr, *yGlyph = nullptr;
 	int32 *ptrSmallBig;
-	byte *ptr;
+	byte *ptr, *glyphMask = nullptr;
 	int i, x, y;
 
 	if (sideLength == 8) {
 		xGlyph = codecGlyph8XVec;
 		yGlyph = codecGlyph8YVec;
+		glyphMask = _glyphMaskBig;
 		ptr = _tableBig;
 		for (i = 0; i < NGLYPHS; i++) {
 			ptr[384] = 0;
@@ -177,6 +183,7 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 	} else if (sideLength == 4) {
 		xGlyph = codecGlyph4XVec;
 		yGlyph = codecGlyph4YVec;
+		glyphMask = _glyphMaskSmall;
 		ptr = _tableSmall;
 		for (i = 0; i < NGLYPHS; i++) {
 			ptr[96] = 0;
@@ -274,6 +281,13 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 				}
 			}
 
+			// The glyph splits the block in two: keep a byte mask of the
+			// part drawn with the first color, so that it can be drawn
+			// a row at a time
+			for (i = 0; i < sideLength * sideLength; i++) {
+				*glyphMask++ = tableSmallBig[i] ? 0xFF : 0;
+			}
+
 			if (sideLength == 8) {
 				for (i = 64 - 1; i >= 0; i--) {
 					if (tableSmallBig[i] != 0) {
@@ -425,20 +439,17 @@ void SmushDeltaGlyphsDecoder::level2(byte *d_dst) {
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		byte *tmpPtr = _tableSmall + *_dSrc++ * 128;
-		int32 l = tmpPtr[96];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[97];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		const byte *mask = _glyphMaskSmall + *_dSrc++ * 16;
+		const uint32 fg = 0x01010101 * _dSrc[0];
+		const uint32 bg = 0x01010101 * _dSrc[1];
+		_dSrc += 2;
+		for (i = 0; i < 4; i++) {
+			uint32 m, pixels;
+			memcpy(&m, mask, 4);
+			pixels = (fg & m) | (bg & ~m);
+			memcpy(d_dst, &pixels, 4);
+			mask += 4;
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
@@ -463,8 +474,7 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	if (code < MOTION_OFFSET_TABLE_SIZE) {
 		tmp = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else if (code == PROCESS_SUBBLOCKS) {
@@ -478,39 +488,32 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	} else if (code == FILL_SINGLE_COLOR) {
 		byte t = *_dSrc++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		tmp = *_dSrc++;
-		byte *tmpPtr = _tableBig + tmp * 388;
-		byte l = tmpPtr[384];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[385];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
+		const byte *mask = _glyphMaskBig + *_dSrc++ * 64;
+		const uint64 fg = 0x0101010101010101ULL * _dSrc[0];
+		const uint64 bg = 0x0101010101010101ULL * _dSrc[1];
+		_dSrc += 2;
+		for (i = 0; i < 8; i++) {
+			uint64 m, pixels;
+			memcpy(&m, mask, 8);
+			pixels = (fg & m) | (bg & ~m);
+			memcpy(d_dst, &pixels, 8);
+			mask += 8;
+			d_dst += _dPitch;
 		}
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	}
@@ -541,7 +544,9 @@ SmushDeltaGlyphsDecoder::SmushDeltaGlyphsDecoder(int width, int height) : _prevS
 	_height = height;
 	_tableBig = (byte *)malloc(NGLYPHS * 388);
 	_tableSmall = (byte *)malloc(NGLYPHS * 128);
-	if ((_tableBig != nullptr) && (_tableSmall != nullptr)) {
+	_glyphMaskBig = (byte *)malloc(NGLYPHS * 64);
+	_glyphMaskSmall = (byte *)malloc(NGLYPHS * 16);
+	if ((_tableBig != nullptr) && (_tableSmall != nullptr) && (_glyphMaskBig != nullptr) && (_glyphMaskSmall != nullptr)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
 	}
@@ -563,6 +568,10 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 		free(_tableSmall);
 		_tableSmall = nullptr;
 	}
+	free(_glyphMaskBig);
+	_glyphMaskBig = nullptr;
+	free(_glyphMaskSmall);
+	_glyphMaskSmall = nullptr;
 	_lastTableWidth = -1;
 	if (_deltaBuf) {
 		free(_deltaBuf);
@@ -574,7 +583,7 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 }
 
 bool SmushDeltaGlyphsDecoder::decode(byte *dst, const byte *src) {
-	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_deltaBuf == nullptr))
+	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_glyphMaskBig == nullptr) || (_glyphMaskSmall == nullptr) || (_deltaBuf == nullptr))
 		return false;
 
 	_offset1 = _deltaBufs[1] - _curBuf;
@@ -20,8 +20,10 @@
  */
 
 #include "common/config-manager.h"
+#include "common/debug-channels.h"
 #include "common/timer.h"
 #include "common/util.h"
+#include "common/memstream.h"
 #include "common/ptr.h"
 #include "common/substream.h"
 
@@ -53,6 +55,41 @@ struct MP3OffsetTable {					/* Compressed Sound (.SO3) */
 	int compressed_size;
 };
 
+// Compressed voice clips up to this size are read in one go and kept in
+// memory, up to the total budget. Longer ones are streamed from the file.
+static const uint32 kMaxCachedVoiceClipSize = 64 * 1024;
+static const uint32 kMaxVoiceClipsSize = 1024 * 1024;
+
+/**
+ * Passes through a sound started by startTalkSound() and reports, on the
+ * sound debug channel, when the mixer first pulls samples from it.
+ */
+class TalkSoundTimingStream : public Audio::AudioStream {
+public:
+	TalkSoundTimingStream(Audio::AudioStream *parent, uint32 offset, uint32 startTime)
+		: _parent(parent), _offset(offset), _startTime(startTime), _reported(false) {}
+	~TalkSoundTimingStream() override { delete _parent; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		if (!_reported) {
+			_reported = true;
+			debugC(DEBUG_SOUND, "startTalkSound: first samples of sound at offset %d read after %d ms", _offset, g_system->getMillis() - _startTime);
+		}
+		return _parent->readBuffer(buffer, numSamples);
+	}
+
+	bool isStereo() const override { return _parent->isStereo(); }
+	int getRate() const override { return _parent->getRate(); }
+	bool endOfData() const override { return _parent->endOfData(); }
+	bool endOfStream() const override { return _parent->endOfStream(); }
+
+private:
+	Audio::AudioStream *_parent;
+	const uint32 _offset;
+	const uint32 _startTime;
+	bool _reported;
+};
+
 
 Sound::Sound(ScummEngine *parent, Audio::Mixer *mixer, bool useReplacementAudioTracks)
 	:
@@ -70,6 +107,10 @@ Sound::Sound(ScummEngine *parent, Audio::Mixer *mixer, bool useReplacementAudioT
 	_sfxFileEncByte(0),
 	_offsetTable(nullptr),
 	_numSoundEffects(0),
+	_voiceClipsSize(0),
+	_voiceClipCounter(0),
+	_voiceFile(nullptr),
+	_voiceFileFailed(false),
 	_soundMode(kVOCMode),
 	_queuedSfxOffset(0),
 	_queuedTalkieOffset(0),
@@ -118,6 +159,7 @@ Sound::~Sound() {
 	stopCDTimer();
 	stopCD();
 	free(_offsetTable);
+	clearVoiceClips();
 	delete _loomSteamCDAudioHandle;
 	delete _talkChannelHandle;
 	if (_vm->_game.version >= 5 && _vm->_game.version <= 7 && _vm->_game.heversion == 0) {
@@ -641,11 +683,103 @@ static Audio::AudioStream *checkForBrokenIndy4Sample(Common::SeekableReadStream
 	);
 }
 
+/**
+ * Look up a sound of the compressed voice file by its offset in the original
+ * file. Also returns the number of mouth sync tags which precede the data.
+ */
+const MP3OffsetTable *Sound::findCompressedSound(uint32 offset, uint32 length, int &numTags) const {
+	MP3OffsetTable key;
+	key.org_offset = offset;
+
+	const MP3OffsetTable *result = (const MP3OffsetTable *)bsearch(&key, _offsetTable, _numSoundEffects,
+										sizeof(MP3OffsetTable), compareMP3OffsetTable);
+
+	numTags = (length > 8) ? (length - 8) >> 1 : 0;
+	if (result && 2 * numTags != result->num_tags)
+		numTags = result->num_tags;
+
+	return result;
+}
+
+/**
+ * Return the given part of the compressed voice file, reading it if it
+ * is not among the recently used clips. The pointer stays valid until
+ * the next call.
+ */
+const byte *Sound::loadVoiceClip(uint32 offset, uint32 size) {
+	for (uint i = 0; i < _voiceClips.size(); i++) {
+		if (_voiceClips[i].offset == offset && _voiceClips[i].size == size) {
+			_voiceClips[i].lastUsed = ++_voiceClipCounter;
+			return _voiceClips[i].data;
+		}
+	}
+
+	if (!_voiceFile) {
+		if (_voiceFileFailed || _sfxFilename.empty())
+			return nullptr;
+
+		_voiceFile = new ScummFile(_vm);
+		if (!_vm->openFile(*_voiceFile, Common::Path(_sfxFilename))) {
+			warning("startTalkSound: could not open sfx file %s", _sfxFilename.c_str());
+			delete _voiceFile;
+			_voiceFile = nullptr;
+			_voiceFileFailed = true;
+			return nullptr;
+		}
+		_voiceFile->setEnc(_sfxFileEncByte);
+	}
+
+	byte *data = (byte *)malloc(size);
+	if (!data)
+		error("startTalkSound: Out of memory");
+
+	_voiceFile->seek(offset, SEEK_SET);
+	if (_voiceFile->read(data, size) != size) {
+		warning("startTalkSound: could not read sound at offset %d", offset);
+		free(data);
+		return nullptr;
+	}
+
+	// Drop the least recently used clips to stay within the budget
+	while (!_voiceClips.empty() && _voiceClipsSize + size > kMaxVoiceClipsSize) {
+		uint oldest = 0;
+		for (uint i = 1; i < _voiceClips.size(); i++) {
+			if (_voiceClips[i].lastUsed < _voiceClips[oldest].lastUsed)
+				oldest = i;
+		}
+		_voiceClipsSize -= _voiceClips[oldest].size;
+		free(_voiceClips[oldest].data);
+		_voiceClips.remove_at(oldest);
+	}
+
+	VoiceClip clip;
+	clip.offset = offset;
+	clip.size = size;
+	clip.data = data;
+	clip.lastUsed = ++_voiceClipCounter;
+	_voiceClips.push_back(clip);
+	_voiceClipsSize += size;
+
+	return data;
+}
+
+void Sound::clearVoiceClips() {
+	for (uint i = 0; i < _voiceClips.size(); i++)
+		free(_voiceClips[i].data);
+	_voiceClips.clear();
+	_voiceClipsSize = 0;
+
+	delete _voiceFile;
+	_voiceFile = nullptr;
+	_voiceFileFailed = false;
+}
+
 void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundHandle *handle) {
 	int num = 0, i;
 	int id = -1;
-	int size = 0;
+	const uint32 startTime = g_system->getMillis();
 	Common::ScopedPtr<ScummFile> file;
+	Common::ScopedPtr<Common::SeekableReadStream> compressedStream;
 
 	if (_vm->_game.id == GID_CMI || (_vm->_game.id == GID_DIG && !(_vm->_game.features & GF_DEMO))) {
 		// COMI (full & demo), DIG (full)
@@ -809,53 +943,80 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 		}
 
 		if (_offsetTable != nullptr) {
-			MP3OffsetTable *result = nullptr, key;
-
-			key.org_offset = offset;
-			result = (MP3OffsetTable *)bsearch(&key, _offsetTable, _numSoundEffects,
-													sizeof(MP3OffsetTable), compareMP3OffsetTable);
+			const int requestedTags = num;
+			const MP3OffsetTable *result = findCompressedSound(offset, length, num);
 
 			if (result == nullptr) {
 				warning("startTalkSound: did not find sound at offset %d", offset);
 				return;
 			}
-			if (2 * num != result->num_tags) {
+			if (2 * requestedTags != result->num_tags) {
 				warning("startTalkSound: number of tags do not match (%d - %d)", length,
 								result->num_tags);
-				num = result->num_tags;
 			}
 			offset = result->new_offset;
-#if defined(USE_FLAC) || defined(USE_VORBIS) || defined(USE_MAD)
-			size = result->compressed_size;
-#endif
+
+			const uint32 clipSize = num * 2 + result->compressed_size;
+			assert(num + 1 < (int)ARRAYSIZE(_mouthSyncTimes));
+
+			if (clipSize <= kMaxCachedVoiceClipSize) {
+				// The mouth sync tags and the compressed data are read in one
+				// go, and the decoder is fed from memory instead of the file
+				const byte *clip = loadVoiceClip(offset, clipSize);
+				if (!clip)
+					return;
+
+				for (i = 0; i < num; i++)
+					_mouthSyncTimes[i] = READ_BE_UINT16(clip + i * 2);
+
+				byte *data = (byte *)malloc(result->compressed_size);
+				if (!data)
+					error("startTalkSound: Out of memory");
+				memcpy(data, clip + num * 2, result->compressed_size);
+				compressedStream.reset(new Common::MemoryReadStream(data, result->compressed_size, DisposeAfterUse::YES));
+			} else {
+				// Only the mouth sync tags of long clips are read here, the
+				// decoder reads the compressed data from the file as it plays
+				file.reset(new ScummFile(_vm));
+				if (!file)
+					error("startTalkSound: Out of memory");
+
+				if (!_vm->openFile(*file, Common::Path(_sfxFilename))) {
+					warning("startTalkSound: could not open sfx file %s", _sfxFilename.c_str());
+					return;
+				}
+
+				file->setEnc(_sfxFileEncByte);
+				file->seek(offset, SEEK_SET);
+				for (i = 0; i < num; i++)
+					_mouthSyncTimes[i] = file->readUint16BE();
+
+				compressedStream.reset(new Common::SeekableSubReadStream(file.release(), offset + num * 2, offset + clipSize, DisposeAfterUse::YES));
+			}
 		} else {
 			offset += 8;
-		}
 
-		file.reset(new ScummFile(_vm));
-		if (!file)
-			error("startTalkSound: Out of memory");
+			file.reset(new ScummFile(_vm));
+			if (!file)
+				error("startTalkSound: Out of memory");
 
-		if (!_vm->openFile(*file, Common::Path(_sfxFilename))) {
-			warning("startTalkSound: could not open sfx file %s", _sfxFilename.c_str());
-			return;
-		}
+			if (!_vm->openFile(*file, Common::Path(_sfxFilename))) {
+				warning("startTalkSound: could not open sfx file %s", _sfxFilename.c_str());
+				return;
+			}
 
-		file->setEnc(_sfxFileEncByte);
-		file->seek(offset, SEEK_SET);
+			file->setEnc(_sfxFileEncByte);
+			file->seek(offset, SEEK_SET);
 
-		assert(num + 1 < (int)ARRAYSIZE(_mouthSyncTimes));
-		for (i = 0; i < num; i++)
-			_mouthSyncTimes[i] = file->readUint16BE();
+			assert(num + 1 < (int)ARRAYSIZE(_mouthSyncTimes));
+			for (i = 0; i < num; i++)
+				_mouthSyncTimes[i] = file->readUint16BE();
 
-		// Adjust offset to account for the mouth sync times. It is noteworthy
-		// that we do not adjust the size here for compressed streams, since
-		// they only set size to the size of the compressed sound data.
-		offset += num * 2;
-		// TODO: In case we ever set up the size for VOC streams, we should
-		// really check whether the size contains the _mouthSyncTimes.
-		//if (_soundMode == kVOCMode)
-		//	size -= num * 2;
+			// Adjust offset to account for the mouth sync times.
+			offset += num * 2;
+			// TODO: In case we ever set up the size for VOC streams, we should
+			// really check whether the size contains the _mouthSyncTimes.
+		}
 
 		_mouthSyncTimes[i] = 0xFFFF;
 		_digiSndMode |= mode;
@@ -869,26 +1030,20 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 		switch (_soundMode) {
 		case kMP3Mode:
 #ifdef USE_MAD
-			{
-			assert(size > 0);
-			input = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+			assert(compressedStream);
+			input = Audio::makeMP3Stream(compressedStream.release(), DisposeAfterUse::YES);
 #endif
 			break;
 		case kVorbisMode:
 #ifdef USE_VORBIS
-			{
-			assert(size > 0);
-			input = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+			assert(compressedStream);
+			input = Audio::makeVorbisStream(compressedStream.release(), DisposeAfterUse::YES);
 #endif
 			break;
 		case kFLACMode:
 #ifdef USE_FLAC
-			{
-			assert(size > 0);
-			input = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+			assert(compressedStream);
+			input = Audio::makeFLACStream(compressedStream.release(), DisposeAfterUse::YES);
 #endif
 			break;
 		default:
@@ -912,12 +1067,18 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 		}
 
 		if (!_vm->_imuseDigital) {
+			if (DebugMan.isDebugChannelEnabled(DEBUG_SOUND))
+				input = new TalkSoundTimingStream(input, offset, startTime);
+
 			if (mode == 1) {
 				_mixer->playStream(Audio::Mixer::kSFXSoundType, handle, input, id);
 			} else {
 				_mixer->playStream(Audio::Mixer::kSpeechSoundType, handle, input, id);
 			}
 		}
+
+		// Time from the request to a stream the mixer can pull samples from
+		debugC(DEBUG_SOUND, "startTalkSound: sound at offset %d (mode %d) ready after %d ms", offset, mode, g_system->getMillis() - startTime);
 	}
 }
 
@@ -1229,6 +1390,7 @@ void Sound::setupSfxFile() {
 
 	ScummFile file(_vm);
 	_offsetTable = nullptr;
+	clearVoiceClips();
 	_sfxFileEncByte = 0;
 	_sfxFilename.clear();
 
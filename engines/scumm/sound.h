@@ -23,6 +23,7 @@
 #define SCUMM_SOUND_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/serializer.h"
 #include "common/str.h"
 #include "audio/mididrv.h"
@@ -88,6 +89,21 @@ protected:
 	MP3OffsetTable *_offsetTable;	// For compressed audio
 	int _numSoundEffects;		// For compressed audio
 
+	// Recently played short clips of the compressed voice file, mouth sync
+	// tags included. The file itself is kept open between lines; if it cannot
+	// be opened, that is not tried again until the next setupSfxFile().
+	struct VoiceClip {
+		uint32 offset;
+		uint32 size;
+		byte *data;
+		uint32 lastUsed;
+	};
+	Common::Array<VoiceClip> _voiceClips;
+	uint32 _voiceClipsSize;
+	uint32 _voiceClipCounter;
+	ScummFile *_voiceFile;
+	bool _voiceFileFailed;
+
 	uint32 _queuedSfxOffset, _queuedTalkieOffset, _queuedSfxLen, _queuedTalkieLen;
 	byte _queuedSoundMode, _queuedSfxChannel;
 	bool _mouthSyncMode;
@@ -171,6 +187,9 @@ public:
 
 protected:
 	void setupSfxFile();
+	const MP3OffsetTable *findCompressedSound(uint32 offset, uint32 length, int &numTags) const;
+	const byte *loadVoiceClip(uint32 offset, uint32 size);
+	void clearVoiceClips();
 	bool isSfxFinished() const;
 	void processSfxQueues();
 
@@ -22,6 +22,7 @@
 #include "twp/debugtools.h"
 #include "backends/imgui/imgui.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "twp/detection.h"
 #include "twp/dialog.h"
 #include "twp/hud.h"
@@ -47,6 +48,7 @@ typedef struct ImGuiState {
 	bool _showResources = false;
 	bool _showScenegraph = false;
 	bool _showActor = false;
+	bool _showProfiler = false;
 	Node *_node = nullptr;
 	ImGuiTextFilter _objFilter;
 	ImGuiTextFilter _actorFilter;
@@ -517,6 +519,9 @@ static void drawGeneral() {
 		ImGui::Checkbox("Audio", &_state->_showAudio);
 		ImGui::Checkbox("Resources", &_state->_showResources);
 		ImGui::Checkbox("Scene graph", &_state->_showScenegraph);
+#ifdef USE_PROFILER
+		ImGui::Checkbox("Profiler", &_state->_showProfiler);
+#endif
 	}
 	ImGui::Separator();
 
@@ -641,6 +646,10 @@ void onImGuiRender() {
 	drawScenegraph();
 	drawActors();
 	drawActor();
+#ifdef USE_PROFILER
+	if (_state->_showProfiler)
+		Common::Profiler::drawImGui(&_state->_showProfiler);
+#endif
 }
 
 void onImGuiCleanup() {
@@ -137,6 +137,14 @@ public:
 	virtual bool displayDebugInfo() {
 		return STATUS_FAILED;
 	};
+	/**
+	 * Get a description of the work done to render the last frame
+	 *
+	 * @return the statistics, or an empty string if the renderer doesn't keep any.
+	 */
+	virtual Common::String getFrameStats() const {
+		return "";
+	}
 	virtual bool drawShaderQuad() {
 		return STATUS_FAILED;
 	}
@@ -35,11 +35,14 @@
 #include "engines/wintermute/base/base_sprite.h"
 #include "engines/util.h"
 
+#include "common/algorithm.h"
 #include "common/system.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Past this many separate dirty rects, they are merged into one.
+#define MAX_DIRTY_RECTS 16
 
 namespace Wintermute {
 
@@ -57,7 +60,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
+	_ticketGridWidth = _ticketGridHeight = 0;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +78,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -134,6 +135,10 @@ bool BaseRenderOSystem::initRenderer(int width, int height, bool windowed) {
 	_renderSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->fillRect(Common::Rect(0, 0, _blankSurface->h, _blankSurface->w), _blankSurface->format.ARGBToColor(255, 0, 0, 0));
+
+	_ticketGridWidth = (_renderSurface->w + kTicketGridCellSize - 1) / kTicketGridCellSize;
+	_ticketGridHeight = (_renderSurface->h + kTicketGridCellSize - 1) / kTicketGridCellSize;
+	_ticketGrid.resize(_ticketGridWidth * _ticketGridHeight);
 	_active = true;
 
 	_clearColor = _renderSurface->format.ARGBToColor(255, 0, 0, 0);
@@ -158,19 +163,17 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
 		// Reset ticketing state
 		_lastFrameIter = _renderQueue.end();
-		RenderQueueIterator it;
-		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-			(*it)->_wantsDraw = false;
-		}
+		resetTickets();
 
 		addDirtyRect(_renderRect);
+		_lastFrameStats = _frameStats;
+		_frameStats = FrameStats();
 		return true;
 	}
 	if (!_disableDirtyRects) {
@@ -180,9 +183,7 @@ bool BaseRenderOSystem::flip() {
 		RenderQueueIterator it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
-				delete ticket;
+				it = deleteTicket(it);
 			} else {
 				(*it)->_wantsDraw = false;
 				++it;
@@ -198,13 +199,15 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
 
+	_frameStats._tickets = _renderQueue.size();
+	_lastFrameStats = _frameStats;
+	_frameStats = FrameStats();
+
 	g_system->updateScreen();
 
 	return STATUS_OK;
@@ -302,31 +305,91 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it = findQueuedTicket(compare);
+		if (it != _renderQueue.end()) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
-	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
+	drawFromTicket(ticket);
+	if (owner) {
+		addToTicketTable(_lastFrameIter);
+	}
+	_frameStats._created++;
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::findQueuedTicket(const RenderTicket &compare) {
+	RenderQueueIterator found = _renderQueue.end();
+	TicketTable::iterator bucket = _ticketTable.find(compare.getHash());
+	if (bucket == _ticketTable.end()) {
+		return found;
+	}
+	// Everything after _lastFrameIter is a ticket from last frame that hasn't been
+	// drawn yet, so take the earliest of those in the original queue order.
+	TicketBucket &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		RenderTicket *ticket = *tickets[i];
+		if (ticket->_wantsDraw || !ticket->_isValid || !(*ticket == compare)) {
+			continue;
+		}
+		if (found == _renderQueue.end() || ticket->_drawNum < (*found)->_drawNum) {
+			found = tickets[i];
+		}
+	}
+	return found;
+}
+
+void BaseRenderOSystem::addToTicketTable(const RenderQueueIterator &ticket) {
+	_ticketTable[(*ticket)->getHash()].push_back(ticket);
+}
+
+void BaseRenderOSystem::updateTicketTable(RenderTicket *ticket, const RenderQueueIterator &newPos) {
+	TicketTable::iterator bucket = _ticketTable.find(ticket->getHash());
+	if (bucket == _ticketTable.end()) {
+		return;
+	}
+	TicketBucket &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		if (*tickets[i] == ticket) {
+			tickets[i] = newPos;
+			return;
+		}
+	}
+}
+
+void BaseRenderOSystem::removeFromTicketTable(RenderTicket *ticket) {
+	// Owner-less tickets, and those from the non-dirty-rect path are never added
+	TicketTable::iterator bucket = _ticketTable.find(ticket->getHash());
+	if (bucket == _ticketTable.end()) {
+		return;
+	}
+	TicketBucket &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		if (*tickets[i] == ticket) {
+			tickets[i] = tickets.back();
+			tickets.pop_back();
+			break;
+		}
+	}
+	if (tickets.empty()) {
+		_ticketTable.erase(bucket);
+	}
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::deleteTicket(const RenderQueueIterator &ticket) {
+	RenderTicket *renderTicket = *ticket;
+	removeFromTicketTable(renderTicket);
+	RenderQueueIterator next = _renderQueue.erase(ticket);
+	delete renderTicket;
+	return next;
+}
+
+void BaseRenderOSystem::resetTickets() {
+	uint32 drawNum = 0;
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
+		(*it)->_drawNum = drawNum++;
 	}
 }
 
@@ -378,16 +441,45 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 		_renderQueue.erase(ticket);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
+		updateTicketTable(renderTicket, _lastFrameIter);
+		_frameStats._reordered++;
+	} else {
+		_frameStats._inOrder++;
 	}
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	// Merge with every rect it overlaps, so that the rects never overlap
+	// each other and no pixel gets redrawn twice.
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		if (_dirtyRects[i].contains(dirty)) {
+			return;
+		}
+		if (_dirtyRects[i].intersects(dirty)) {
+			dirty.extend(_dirtyRects[i]);
+			_dirtyRects[i] = _dirtyRects.back();
+			_dirtyRects.pop_back();
+			// The grown rect may overlap rects that were already checked
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+	_dirtyRects.push_back(dirty);
+
+	if (_dirtyRects.size() > MAX_DIRTY_RECTS) {
+		for (i = 1; i < _dirtyRects.size(); i++) {
+			_dirtyRects[0].extend(_dirtyRects[i]);
+		}
+		_dirtyRects.resize(1);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -398,47 +490,127 @@ void BaseRenderOSystem::drawTickets() {
 	// we have a copy of their data, so their invalidness won't affect us.
 	while (it != _renderQueue.end()) {
 		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+			it = deleteTicket(it);
 		} else {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
-		it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			RenderTicket *ticket = *it;
-			ticket->_wantsDraw = false;
-			++it;
-		}
+	if (_dirtyRects.empty()) {
+		resetTickets();
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	resetTickets();
+	_frameStats._dirtyRects = _dirtyRects.size();
+
+	Common::Array<uint32> candidates;
+	if (_dirtyRects.size() == 1) {
+		// Every ticket has to be checked anyway, so skip the grid.
+		_frameTickets.clear();
+		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+			candidates.push_back(_frameTickets.size());
+			_frameTickets.push_back(*it);
+		}
+		drawTicketsInRect(_dirtyRects[0], candidates);
+	} else {
+		buildTicketGrid();
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			const Common::Rect &dirtyRect = _dirtyRects[i];
+			int left = CLIP<int>(dirtyRect.left / kTicketGridCellSize, 0, _ticketGridWidth - 1);
+			int top = CLIP<int>(dirtyRect.top / kTicketGridCellSize, 0, _ticketGridHeight - 1);
+			int right = CLIP<int>((dirtyRect.right - 1) / kTicketGridCellSize, 0, _ticketGridWidth - 1);
+			int bottom = CLIP<int>((dirtyRect.bottom - 1) / kTicketGridCellSize, 0, _ticketGridHeight - 1);
+
+			candidates.clear();
+			for (int y = top; y <= bottom; y++) {
+				for (int x = left; x <= right; x++) {
+					candidates.push_back(_ticketGrid[y * _ticketGridWidth + x]);
+				}
+			}
+			// Restore the drawing order, and drop tickets spanning several cells more than once.
+			Common::sort(candidates.begin(), candidates.end());
+			uint unique = 0;
+			for (uint j = 0; j < candidates.size(); j++) {
+				if (unique == 0 || candidates[unique - 1] != candidates[j]) {
+					candidates[unique++] = candidates[j];
+				}
+			}
+			candidates.resize(unique);
+
+			drawTicketsInRect(dirtyRect, candidates);
+		}
+	}
+
+	// Don't leave dangling pointers around once the tickets get deleted.
+	_frameTickets.clear();
+
+	it = _renderQueue.begin();
+	// Clean out the old tickets
+	while (it != _renderQueue.end()) {
+		if ((*it)->_isValid == false) {
+			addDirtyRect((*it)->_dstRect);
+			it = deleteTicket(it);
+		} else {
+			++it;
+		}
+	}
+
+}
+
+void BaseRenderOSystem::buildTicketGrid() {
+	for (uint i = 0; i < _ticketGrid.size(); i++) {
+		_ticketGrid[i].clear();
+	}
+	_frameTickets.clear();
+
+	Common::Rect screen(_renderSurface->w, _renderSurface->h);
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		Common::Rect area((*it)->_dstRect);
+		area.clip(screen);
+		if (area.isEmpty()) {
+			continue;
+		}
+		uint32 index = _frameTickets.size();
+		_frameTickets.push_back(*it);
+
+		int left = area.left / kTicketGridCellSize;
+		int top = area.top / kTicketGridCellSize;
+		int right = (area.right - 1) / kTicketGridCellSize;
+		int bottom = (area.bottom - 1) / kTicketGridCellSize;
+		for (int y = top; y <= bottom; y++) {
+			for (int x = left; x <= right; x++) {
+				_ticketGrid[y * _ticketGridWidth + x].push_back(index);
+			}
+		}
+	}
+}
+
+void BaseRenderOSystem::drawTicketsInRect(const Common::Rect &dirtyRect, const Common::Array<uint32> &candidates) {
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	RenderTicket *front = _renderQueue.empty() ? nullptr : _renderQueue.front();
+	if (front && front == _renderQueue.back() && front->_transform._alphaDisable == true) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (dirtyRect != front->_dstRect) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRect, _clearColor);
 		}
 		// Otherwise Do NOT fill.
 	} else {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		_renderSurface->fillRect(dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+	for (uint i = 0; i < candidates.size(); i++) {
+		RenderTicket *ticket = _frameTickets[candidates[i]];
+		if (ticket->_dstRect.intersects(dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -448,25 +620,10 @@ void BaseRenderOSystem::drawTickets() {
 
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
-		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
-	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
+			_frameStats._drawn++;
 		}
 	}
-
+	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -578,15 +735,22 @@ BaseSurface *BaseRenderOSystem::createSurface() {
 	return new BaseSurfaceOSystem(_gameRef);
 }
 
+Common::String BaseRenderOSystem::getFrameStats() const {
+	if (_disableDirtyRects) {
+		return Common::String::format("Dirty rects disabled, %d tickets drawn", _lastFrameStats._tickets);
+	}
+	return Common::String::format("Tickets: %d (%d in order, %d reordered, %d new)\nDirty rects: %d, ticket draws: %d",
+	                              _lastFrameStats._tickets, _lastFrameStats._inOrder, _lastFrameStats._reordered,
+	                              _lastFrameStats._created, _lastFrameStats._dirtyRects, _lastFrameStats._drawn);
+}
+
 void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
 	RenderQueueIterator it = _renderQueue.begin();
 	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
+		it = deleteTicket(it);
 	}
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
@@ -30,6 +30,8 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 #include "common/list.h"
 
@@ -54,6 +56,11 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * To avoid comparing every incoming draw-call against every queued ticket, the
+ * tickets are kept in a hash table keyed on their draw arguments. Redrawing is
+ * done per dirty rect, and the tickets overlapping each rect are found through
+ * a coarse grid over the screen instead of testing every ticket.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -116,7 +123,51 @@ public:
 	void endSaveLoad() override;
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
+	Common::String getFrameStats() const override;
 private:
+	/**
+	 * Per-frame counters of the ticket system, shown by the debugger.
+	 */
+	struct FrameStats {
+		uint32 _tickets;   ///< Tickets in the queue at flip-time
+		uint32 _inOrder;   ///< Draw-calls matching a ticket in the same position as last frame
+		uint32 _reordered; ///< Draw-calls matching a ticket that had to be moved
+		uint32 _created;   ///< Draw-calls that needed a new ticket
+		uint32 _dirtyRects;
+		uint32 _drawn;     ///< Ticket draws needed to repair the dirty rects
+
+		FrameStats() : _tickets(0), _inOrder(0), _reordered(0), _created(0), _dirtyRects(0), _drawn(0) {}
+	};
+
+	typedef Common::Array<RenderQueueIterator> TicketBucket;
+	typedef Common::HashMap<uint32, TicketBucket> TicketTable;
+
+	/**
+	 * Find the first ticket after _lastFrameIter that matches compare,
+	 * or _renderQueue.end() if there is none.
+	 */
+	RenderQueueIterator findQueuedTicket(const RenderTicket &compare);
+	void addToTicketTable(const RenderQueueIterator &ticket);
+	void updateTicketTable(RenderTicket *ticket, const RenderQueueIterator &newPos);
+	void removeFromTicketTable(RenderTicket *ticket);
+	/**
+	 * Remove a ticket from the queue and free it.
+	 * @return iterator pointing to the following ticket.
+	 */
+	RenderQueueIterator deleteTicket(const RenderQueueIterator &ticket);
+	/**
+	 * Number the tickets in queue order, and mark them as not drawn yet.
+	 */
+	void resetTickets();
+	/**
+	 * Sort the tickets into the screen grid, for use by drawTickets()
+	 */
+	void buildTicketGrid();
+	/**
+	 * Redraw a single dirty rect from the tickets in candidates, which
+	 * are indices into _frameTickets in drawing order.
+	 */
+	void drawTicketsInRect(const Common::Rect &dirtyRect, const Common::Array<uint32> &candidates);
 	/**
 	 * Mark a specified rect of the screen as dirty.
 	 * @param rect the region to be marked as dirty
@@ -130,8 +181,20 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
+	TicketTable _ticketTable;
+
+	// Size in pixels of a single cell of the ticket grid
+	static const int kTicketGridCellSize = 64;
+	// The queue flattened into an array, and the indices into it touching each grid cell.
+	Common::Array<RenderTicket *> _frameTickets;
+	Common::Array<Common::Array<uint32> > _ticketGrid;
+	int _ticketGridWidth;
+	int _ticketGridHeight;
+
+	FrameStats _frameStats;
+	FrameStats _lastFrameStats;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
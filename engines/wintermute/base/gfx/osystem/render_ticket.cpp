@@ -43,7 +43,19 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	        _dstRect(*dstRect),
 	        _isValid(true),
 	        _wantsDraw(true),
+	        _drawNum(0),
 	        _transform(transform) {
+	_hash = (uint32)(uintptr)owner;
+	_hash = _hash * 31 + (uint16)_dstRect.left;
+	_hash = _hash * 31 + (uint16)_dstRect.top;
+	_hash = _hash * 31 + (uint16)_dstRect.right;
+	_hash = _hash * 31 + (uint16)_dstRect.bottom;
+	_hash = _hash * 31 + (uint16)_srcRect.left;
+	_hash = _hash * 31 + (uint16)_srcRect.top;
+	_hash = _hash * 31 + (uint16)_srcRect.right;
+	_hash = _hash * 31 + (uint16)_srcRect.bottom;
+	_hash = _hash * 31 + _transform._rgbaMod;
+
 	if (surf) {
 		_surface = new Graphics::Surface();
 		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
@@ -51,7 +51,7 @@ class BaseSurfaceOSystem;
 class RenderTicket {
 public:
 	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
+	RenderTicket() : _isValid(true), _wantsDraw(false), _drawNum(0), _transform(Graphics::TransformStruct()), _hash(0) {}
 	~RenderTicket();
 	const Graphics::Surface *getSurface() const { return _surface; }
 	// Non-dirty-rects:
@@ -63,15 +63,26 @@ public:
 
 	bool _isValid;
 	bool _wantsDraw;
+	/**
+	 * Position of the ticket in the render queue as of the last drawn frame,
+	 * used to pick the earliest of several identical tickets.
+	 */
+	uint32 _drawNum;
 
 	Graphics::TransformStruct _transform;
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/**
+	 * Hash of the fields compared by operator==, tickets that compare
+	 * equal always have the same hash.
+	 */
+	uint32 getHash() const { return _hash; }
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
 	Common::Rect _srcRect;
+	uint32 _hash;
 };
 
 } // End of namespace Wintermute
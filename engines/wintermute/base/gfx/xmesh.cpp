@@ -36,6 +36,8 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/math/math_util.h"
 
+#include "common/profiler.h"
+
 namespace Wintermute {
 
 XMesh::XMesh(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame) {
@@ -46,6 +48,10 @@ XMesh::XMesh(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame) {
 
 	_BBoxStart = Math::Vector3d(0.0f, 0.0f, 0.0f);
 	_BBoxEnd = Math::Vector3d(0.0f, 0.0f, 0.0f);
+
+#ifdef SCUMMVM_SSE2
+	_hasSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 }
 
 XMesh::~XMesh() {
@@ -80,7 +86,7 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 	if (!_skinnedMesh) {
 		return true;
 	}
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	_boneMatrices.resize(skinWeightsList.size());
 
@@ -94,9 +100,87 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 		}
 	}
 
+	buildVertexInfluences();
+
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void XMesh::buildVertexInfluences() {
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
+
+	// count the influences of every vertex, and turn the counts into offsets
+	_influenceStart.clear();
+	_influenceStart.resize(vertexCount + 1);
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const BaseArray<uint32> &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+		for (uint i = 0; i < vertexIndices.size(); ++i) {
+			if (vertexIndices[i] < vertexCount) {
+				_influenceStart[vertexIndices[i] + 1]++;
+			}
+		}
+	}
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		_influenceStart[i + 1] += _influenceStart[i];
+	}
+
+	_influenceBones.resize(_influenceStart[vertexCount]);
+	_influenceWeights.resize(_influenceStart[vertexCount]);
+
+	// going through the bones in order keeps the summation order of update() the same
+	BaseArray<uint32> next;
+	next.resize(vertexCount);
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		next[i] = _influenceStart[i];
+	}
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const BaseArray<uint32> &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+		for (uint i = 0; i < vertexIndices.size(); ++i) {
+			uint32 vertexIndex = vertexIndices[i];
+			if (vertexIndex < vertexCount) {
+				uint32 pos = next[vertexIndex]++;
+				_influenceBones[pos] = boneIndex;
+				_influenceWeights[pos] = skinWeightsList[boneIndex]._vertexWeights[i];
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+void XMesh::skinVertices(float *vertexData, const float *positions, const float *normals, uint32 vertexCount,
+						 const uint32 *influenceStart, const uint32 *influenceBones, const float *influenceWeights,
+						 const Math::Matrix4 *boneMatrices, const Math::Matrix4 *normalMatrices) {
+	// the new vertex coordinates are the weighted sum of the product
+	// of the combined bone transformation matrices and the static pose coordinates,
+	// and the same goes for the normals. All the bones affecting a vertex
+	// are applied at once, so every vertex is only written once.
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		const float *pos = positions + i * 3;
+		const float *normal = normals + i * 3;
+		float newPos[3] = { 0.0f, 0.0f, 0.0f };
+		float newNormal[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (uint32 k = influenceStart[i]; k < influenceStart[i + 1]; ++k) {
+			const float *m = boneMatrices[influenceBones[k]].getData();
+			const float *n = normalMatrices[influenceBones[k]].getData();
+			float weight = influenceWeights[k];
+
+			// matrices are stored row-major, positions get the translation applied
+			for (int j = 0; j < 3; ++j) {
+				newPos[j] += (m[j * 4 + 0] * pos[0] + m[j * 4 + 1] * pos[1] + m[j * 4 + 2] * pos[2] + m[j * 4 + 3]) * weight;
+				newNormal[j] += (n[j * 4 + 0] * normal[0] + n[j * 4 + 1] * normal[1] + n[j * 4 + 2] * normal[2]) * weight;
+			}
+		}
+
+		float *dest = vertexData + i * XSkinMeshLoader::kVertexComponentCount;
+		for (int j = 0; j < 3; ++j) {
+			dest[XSkinMeshLoader::kPositionOffset + j] = newPos[j];
+			dest[XSkinMeshLoader::kNormalOffset + j] = newNormal[j];
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
@@ -107,70 +191,39 @@ bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
 	float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	// update skinned mesh
 	if (_skinnedMesh) {
+		if (_influenceStart.size() != vertexCount + 1) {
+			buildVertexInfluences();
+		}
+
 		BaseArray<Math::Matrix4> finalBoneMatrices;
+		BaseArray<Math::Matrix4> normalBoneMatrices;
 		finalBoneMatrices.resize(_boneMatrices.size());
+		normalBoneMatrices.resize(_boneMatrices.size());
 
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
 			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
-		}
 
-		// the new vertex coordinates are the weighted sum of the product
-		// of the combined bone transformation matrices and the static pose coordinates
-		// to be able too add the weighted summands together, we reset everything to zero first
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
-			}
+			// the vertex normals are transformed by the inverse transpose
+			normalBoneMatrices[i] = finalBoneMatrices[i];
+			normalBoneMatrices[i].transpose();
+			normalBoneMatrices[i].inverse();
 		}
 
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			// to every vertex which is affected by the bone, we add the product
-			// of the bone transformation with the coordinates of the static pose,
-			// weighted by the weight for the particular vertex
-			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] += pos.getData()[j];
-				}
-			}
-		}
-
-		// now we have to update the vertex normals as well, so prepare the bone transformations
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
-		}
-
-		// reset so we can form the weighted sums
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
-			}
-		}
-
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] += pos.getData()[j];
-				}
-			}
-		}
+		PROFILE_SCOPE("XMesh::skinVertices");
+#ifdef SCUMMVM_SSE2
+		if (_hasSSE2)
+			skinVerticesSSE2(vertexData, vertexPositionData, vertexNormalData, vertexCount,
+							 _influenceStart.data(), _influenceBones.data(), _influenceWeights.data(),
+							 finalBoneMatrices.data(), normalBoneMatrices.data());
+		else
+#endif
+			skinVertices(vertexData, vertexPositionData, vertexNormalData, vertexCount,
+						 _influenceStart.data(), _influenceBones.data(), _influenceWeights.data(),
+						 finalBoneMatrices.data(), normalBoneMatrices.data());
 
 	//updateNormals();
 	} else { // update static
@@ -72,6 +72,27 @@ public:
 protected:
 
 	void updateBoundingBox();
+	/**
+	 * Regroup the per-bone vertex weights by vertex, for use by update()
+	 */
+	void buildVertexInfluences();
+	/**
+	 * Write the skinned positions and normals of all vertices into vertexData,
+	 * using the influences built by buildVertexInfluences()
+	 */
+	static void skinVertices(float *vertexData, const float *positions, const float *normals, uint32 vertexCount,
+							 const uint32 *influenceStart, const uint32 *influenceBones, const float *influenceWeights,
+							 const Math::Matrix4 *boneMatrices, const Math::Matrix4 *normalMatrices);
+#ifdef SCUMMVM_SSE2
+	/**
+	 * Same as skinVertices(), but blends the bone matrices of each vertex
+	 * before transforming it (xmesh_sse2.cpp)
+	 */
+	static void skinVerticesSSE2(float *vertexData, const float *positions, const float *normals, uint32 vertexCount,
+								 const uint32 *influenceStart, const uint32 *influenceBones, const float *influenceWeights,
+								 const Math::Matrix4 *boneMatrices, const Math::Matrix4 *normalMatrices);
+	bool _hasSSE2;
+#endif
 
 	uint32 _numAttrs;
 
@@ -84,6 +105,12 @@ protected:
 
 	BaseArray<Math::Matrix4 *> _boneMatrices;
 
+	// The bones influencing vertex i, with their weights, are found at
+	// [_influenceStart[i], _influenceStart[i + 1]) in the two arrays below.
+	BaseArray<uint32> _influenceStart;
+	BaseArray<uint32> _influenceBones;
+	BaseArray<float> _influenceWeights;
+
 	Common::Array<uint32> _adjacency;
 
 	BaseArray<Material *> _materials;
@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+#include "engines/wintermute/base/gfx/xmesh.h"
+#include "engines/wintermute/base/gfx/xskinmesh_loader.h"
+
+namespace Wintermute {
+
+void XMesh::skinVerticesSSE2(float *vertexData, const float *positions, const float *normals, uint32 vertexCount,
+							 const uint32 *influenceStart, const uint32 *influenceBones, const float *influenceWeights,
+							 const Math::Matrix4 *boneMatrices, const Math::Matrix4 *normalMatrices) {
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		// blend the top three rows of the bone matrices by the weights,
+		// then transform the vertex once by the blended matrices
+		__m128 m0 = _mm_setzero_ps(), m1 = _mm_setzero_ps(), m2 = _mm_setzero_ps();
+		__m128 n0 = _mm_setzero_ps(), n1 = _mm_setzero_ps(), n2 = _mm_setzero_ps();
+
+		for (uint32 k = influenceStart[i]; k < influenceStart[i + 1]; ++k) {
+			const float *m = boneMatrices[influenceBones[k]].getData();
+			const float *n = normalMatrices[influenceBones[k]].getData();
+			const __m128 weight = _mm_set1_ps(influenceWeights[k]);
+
+			m0 = _mm_add_ps(m0, _mm_mul_ps(_mm_loadu_ps(m + 0), weight));
+			m1 = _mm_add_ps(m1, _mm_mul_ps(_mm_loadu_ps(m + 4), weight));
+			m2 = _mm_add_ps(m2, _mm_mul_ps(_mm_loadu_ps(m + 8), weight));
+			n0 = _mm_add_ps(n0, _mm_mul_ps(_mm_loadu_ps(n + 0), weight));
+			n1 = _mm_add_ps(n1, _mm_mul_ps(_mm_loadu_ps(n + 4), weight));
+			n2 = _mm_add_ps(n2, _mm_mul_ps(_mm_loadu_ps(n + 8), weight));
+		}
+
+		// positions get the translation applied, normals don't
+		const float *pos = positions + i * 3;
+		const float *normal = normals + i * 3;
+		const __m128 p = _mm_set_ps(1.0f, pos[2], pos[1], pos[0]);
+		const __m128 q = _mm_set_ps(0.0f, normal[2], normal[1], normal[0]);
+
+		// the row dot products are summed up by transposing the products
+		__m128 p0 = _mm_mul_ps(m0, p), p1 = _mm_mul_ps(m1, p), p2 = _mm_mul_ps(m2, p), p3 = _mm_setzero_ps();
+		__m128 q0 = _mm_mul_ps(n0, q), q1 = _mm_mul_ps(n1, q), q2 = _mm_mul_ps(n2, q), q3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		_MM_TRANSPOSE4_PS(q0, q1, q2, q3);
+
+		float newPos[4], newNormal[4];
+		_mm_storeu_ps(newPos, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+		_mm_storeu_ps(newNormal, _mm_add_ps(_mm_add_ps(q0, q1), _mm_add_ps(q2, q3)));
+
+		float *dest = vertexData + i * XSkinMeshLoader::kVertexComponentCount;
+		for (int j = 0; j < 3; ++j) {
+			dest[XSkinMeshLoader::kPositionOffset + j] = newPos[j];
+			dest[XSkinMeshLoader::kNormalOffset + j] = newNormal[j];
+		}
+	}
+}
+
+} // End of namespace Wintermute
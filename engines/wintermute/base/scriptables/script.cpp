@@ -56,6 +56,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolAtoms = nullptr;
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -188,6 +189,12 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
+	_symbolAtoms = new ScAtom[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		_symbolAtoms[i] = atoms->intern(_symbols[i]);
+	}
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -395,6 +402,8 @@ void ScScript::cleanup() {
 		delete[] _symbols;
 	}
 	_symbols = nullptr;
+	delete[] _symbolAtoms;
+	_symbolAtoms = nullptr;
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -571,9 +580,9 @@ bool ScScript::executeInstruction() {
 		_operand->setNULL();
 		dw = getDWORD();
 		if (_scopeStack->_sP < 0) {
-			_globals->setProp(_symbols[dw], _operand);
+			_globals->setProp(_symbolAtoms[dw], _operand);
 		} else {
-			_scopeStack->getTop()->setProp(_symbols[dw], _operand);
+			_scopeStack->getTop()->setProp(_symbolAtoms[dw], _operand);
 		}
 
 		break;
@@ -583,9 +592,9 @@ bool ScScript::executeInstruction() {
 		dw = getDWORD();
 		/*      char *temp = _symbols[dw]; // TODO delete */
 		// only create global var if it doesn't exist
-		if (!_engine->_globals->propExists(_symbols[dw])) {
+		if (!_engine->_globals->propExists(_symbolAtoms[dw])) {
 			_operand->setNULL();
-			_engine->_globals->setProp(_symbols[dw], _operand, false, inst == II_DEF_CONST_VAR);
+			_engine->_globals->setProp(_symbolAtoms[dw], _operand, false, inst == II_DEF_CONST_VAR);
 		}
 		break;
 	}
@@ -742,7 +751,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolAtoms[getDWORD()]);
 		// Disabled in original code
 		/*if (false && var->_type==VAL_OBJECT || var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
@@ -754,15 +763,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolAtoms[getDWORD()]);
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(_symbolAtoms[getDWORD()]);
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -813,7 +821,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(_symbolAtoms[getDWORD()]));
 		_thisStack->push(_operand);
 		break;
 
@@ -1173,40 +1181,46 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScScript::getVar(char *name) {
+	return getVar(BaseEngine::instance().getAtomTable()->intern(name));
+}
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(ScAtom atom) {
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
+		if (_scopeStack->getTop()->propExists(atom)) {
+			ret = _scopeStack->getTop()->getProp(atom);
 		}
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
+		if (_globals->propExists(atom)) {
+			ret = _globals->getProp(atom);
 		}
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
+		if (_engine->_globals->propExists(atom)) {
+			ret = _engine->_globals->getProp(atom);
 		}
 	}
 
 	if (ret == nullptr) {
+		const char *name = BaseEngine::instance().getAtomTable()->getName(atom);
 		//RuntimeError("Variable '%s' is inaccessible in the current block. Consider changing the script.", name);
 		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name, _filename, _currentLine);
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setProp(atom, val);
+			ret = _scopeStack->getTop()->getProp(atom);
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setProp(atom, val);
+			ret = _globals->getProp(atom);
 		}
 		delete val;
 	}
@@ -0,0 +1,65 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WINTERMUTE_SCATOMS_H
+#define WINTERMUTE_SCATOMS_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+namespace Wintermute {
+
+typedef uint32 ScAtom;
+
+/**
+ * Table of interned variable and property names.
+ * Every distinct name is given a small integer, the atom, which ScValue
+ * uses to key its properties. Scripts intern their symbols once when they
+ * are loaded, so running them doesn't need to hash and compare strings.
+ * Names are never removed, and the table lives as long as BaseEngine.
+ */
+class ScAtomTable {
+public:
+	static const ScAtom kNoAtom = 0xFFFFFFFF;
+
+	/**
+	 * Get the atom for a name, adding the name if it wasn't known yet.
+	 */
+	ScAtom intern(const char *name);
+	/**
+	 * Get the atom for a name, or kNoAtom if it was never interned,
+	 * in which case no ScValue can have a property of that name.
+	 */
+	ScAtom find(const char *name) const;
+	const char *getName(ScAtom atom) const { return _names[atom]->c_str(); }
+
+private:
+	typedef Common::HashMap<Common::String, ScAtom> AtomMap;
+	AtomMap _atoms;
+	// Points into the keys of _atoms, which never move
+	Common::Array<const Common::String *> _names;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -74,9 +74,7 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 	}
 
 	// prepare script cache
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		_cachedScripts[i] = nullptr;
-	}
+	_cachedScriptsSize = 0;
 
 	_currentScript = nullptr;
 
@@ -198,12 +196,17 @@ bool ScEngine::isRunningScript(const char *filename) {
 byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache) {
 	// is script in cache?
 	if (!ignoreCache) {
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] && scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
-				_cachedScripts[i]->_timestamp = g_system->getMillis();
-				*outSize = _cachedScripts[i]->_size;
-				return _cachedScripts[i]->_buffer;
+		ScriptCacheIndex::iterator entry = _cachedScriptIndex.find(filename);
+		if (entry != _cachedScriptIndex.end()) {
+			CScCachedScript *cachedScript = *entry->_value;
+			// move it to the front
+			if (entry->_value != _cachedScripts.begin()) {
+				_cachedScripts.erase(entry->_value);
+				_cachedScripts.push_front(cachedScript);
+				entry->_value = _cachedScripts.begin();
 			}
+			*outSize = cachedScript->_size;
+			return cachedScript->_buffer;
 		}
 	}
 
@@ -234,37 +237,33 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 		error("Script needs compilation, ScummVM does not contain a WME compiler");
 	}
 
-	byte *ret = nullptr;
+	// add script to cache, replacing any older copy
+	ScriptCacheIndex::iterator entry = _cachedScriptIndex.find(filename);
+	if (entry != _cachedScriptIndex.end()) {
+		removeCachedScript(entry);
+	}
 
-	// add script to cache
 	CScCachedScript *cachedScript = new CScCachedScript(filename, compBuffer, compSize);
-	if (cachedScript) {
-		int index = 0;
-		uint32 minTime = g_system->getMillis();
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] == nullptr) {
-				index = i;
-				break;
-			} else if (_cachedScripts[i]->_timestamp <= minTime) {
-				minTime = _cachedScripts[i]->_timestamp;
-				index = i;
-			}
-		}
-
-		if (_cachedScripts[index] != nullptr) {
-			delete _cachedScripts[index];
-		}
-		_cachedScripts[index] = cachedScript;
+	_cachedScripts.push_front(cachedScript);
+	_cachedScriptIndex[filename] = _cachedScripts.begin();
+	_cachedScriptsSize += compSize;
 
-		ret = cachedScript->_buffer;
-		*outSize = cachedScript->_size;
+	// drop the least recently used scripts, but always keep the new one
+	while (_cachedScriptsSize > MAX_SCRIPT_CACHE_SIZE && _cachedScripts.back() != cachedScript) {
+		removeCachedScript(_cachedScriptIndex.find(_cachedScripts.back()->_filename));
 	}
 
+	*outSize = cachedScript->_size;
+	return cachedScript->_buffer;
+}
 
-	// cleanup
-	delete[] buffer;
-
-	return ret;
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::removeCachedScript(const ScriptCacheIndex::iterator &entry) {
+	CScCachedScript *cachedScript = *entry->_value;
+	_cachedScriptsSize -= cachedScript->_size;
+	_cachedScripts.erase(entry->_value);
+	_cachedScriptIndex.erase(entry);
+	delete cachedScript;
 }
 
 
@@ -479,12 +478,12 @@ int ScEngine::getNumScripts(int *running, int *waiting, int *persistent) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::emptyScriptCache() {
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		if (_cachedScripts[i]) {
-			delete _cachedScripts[i];
-			_cachedScripts[i] = nullptr;
-		}
+	for (ScriptCache::iterator it = _cachedScripts.begin(); it != _cachedScripts.end(); ++it) {
+		delete *it;
 	}
+	_cachedScripts.clear();
+	_cachedScriptIndex.clear();
+	_cachedScriptsSize = 0;
 	return STATUS_OK;
 }
 
@@ -32,9 +32,14 @@
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
 
+#include "common/hash-str.h"
+#include "common/list.h"
+
 namespace Wintermute {
 
-#define MAX_CACHED_SCRIPTS 20
+// Compiled scripts are cached until they take up this many bytes, past
+// that the least recently used ones are dropped.
+#define MAX_SCRIPT_CACHE_SIZE (2 * 1024 * 1024)
 class ScScript;
 class ScValue;
 class BaseObject;
@@ -43,12 +48,9 @@ class ScEngine : public BaseClass {
 public:
 	class CScCachedScript {
 	public:
+		// Takes ownership of buffer
 		CScCachedScript(const char *filename, byte *buffer, uint32 size) {
-			_timestamp = g_system->getMillis();
-			_buffer = new byte[size];
-			if (_buffer) {
-				memcpy(_buffer, buffer, size);
-			}
+			_buffer = buffer;
 			_size = size;
 			_filename = filename;
 		};
@@ -59,7 +61,6 @@ public:
 			}
 		};
 
-		uint32 _timestamp;
 		byte *_buffer;
 		uint32 _size;
 		Common::String _filename;
@@ -106,8 +107,15 @@ public:
 	void dumpStats();
 
 private:
+	typedef Common::List<CScCachedScript *> ScriptCache;
+	typedef Common::HashMap<Common::String, ScriptCache::iterator, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> ScriptCacheIndex;
+
+	void removeCachedScript(const ScriptCacheIndex::iterator &entry);
 
-	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
+	// Most recently used first
+	ScriptCache _cachedScripts;
+	ScriptCacheIndex _cachedScriptIndex;
+	uint32 _cachedScriptsSize;
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
@@ -27,6 +27,7 @@
 
 #include "engines/wintermute/platform_osystem.h"
 #include "engines/wintermute/base/base_dynamic_buffer.h"
+#include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script.h"
@@ -53,6 +54,7 @@ ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	_valObject = nullptr;
 }
 
 
@@ -68,6 +70,7 @@ ScValue::ScValue(BaseGame *inGame, bool val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	_valObject = nullptr;
 }
 
 
@@ -83,6 +86,7 @@ ScValue::ScValue(BaseGame *inGame, int32 val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	_valObject = nullptr;
 }
 
 
@@ -98,6 +102,7 @@ ScValue::ScValue(BaseGame *inGame, double val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	_valObject = nullptr;
 }
 
 
@@ -114,6 +119,7 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	_valObject = nullptr;
 }
 
 
@@ -182,24 +188,50 @@ ScValue *ScValue::getProp(const char *name) {
 	}
 
 	if (ret == nullptr) {
-		_valIter = _valObject.find(name);
-		if (_valIter != _valObject.end()) {
-			ret = _valIter->_value;
-		}
+		ret = findProp(BaseEngine::instance().getAtomTable()->find(name));
 	}
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::getProp(ScAtom atom) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->getProp(atom);
+	}
+
+	// strings and natives have built-in properties, which are looked up by name
+	if (_type == VAL_STRING || _type == VAL_NATIVE) {
+		return getProp(BaseEngine::instance().getAtomTable()->getName(atom));
+	}
+
+	return findProp(atom);
+}
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::findProp(ScAtom atom) const {
+	if (!_valObject) {
+		return nullptr;
+	}
+
+	PropertyMap::const_iterator it = _valObject->find(atom);
+	if (it != _valObject->end()) {
+		return it->_value;
+	}
+	return nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->deleteProp(name);
 	}
 
-	_valIter = _valObject.find(name);
-	if (_valIter != _valObject.end()) {
-		delete _valIter->_value;
-		_valIter->_value = nullptr;
+	if (_valObject) {
+		PropertyMap::iterator it = _valObject->find(BaseEngine::instance().getAtomTable()->find(name));
+		if (it != _valObject->end()) {
+			delete it->_value;
+			it->_value = nullptr;
+		}
 	}
 
 	return STATUS_OK;
@@ -219,42 +251,45 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 	}
 
 	if (DID_FAIL(ret)) {
-		ScValue *newVal = nullptr;
+		storeProp(BaseEngine::instance().getAtomTable()->intern(name), val, copyWhole, setAsConst);
+	}
 
-		_valIter = _valObject.find(name);
-		if (_valIter != _valObject.end()) {
-			newVal = _valIter->_value;
-		}
-		if (!newVal) {
-			newVal = new ScValue(_gameRef);
-		} else {
-			newVal->cleanup();
-		}
+	return STATUS_OK;
+}
 
-		newVal->copy(val, copyWhole);
-		newVal->_isConstVar = setAsConst;
-		_valObject[name] = newVal;
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::setProp(ScAtom atom, ScValue *val, bool copyWhole, bool setAsConst) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->setProp(atom, val);
+	}
 
-		if (_type != VAL_NATIVE) {
-			_type = VAL_OBJECT;
-		}
+	if (_type == VAL_NATIVE && _valNative) {
+		return setProp(BaseEngine::instance().getAtomTable()->getName(atom), val, copyWhole, setAsConst);
+	}
 
-		/*
-		_valIter = _valObject.find(Name);
-		if (_valIter != _valObject.end()) {
-		    delete _valIter->_value;
-		    _valIter->_value = nullptr;
-		}
-		ScValue* val = new ScValue(_gameRef);
-		val->Copy(Val, CopyWhole);
-		val->_isConstVar = SetAsConst;
-		_valObject[Name] = val;
+	storeProp(atom, val, copyWhole, setAsConst);
+	return STATUS_OK;
+}
 
-		if (_type!=VAL_NATIVE) _type = VAL_OBJECT;
-		*/
+//////////////////////////////////////////////////////////////////////////
+void ScValue::storeProp(ScAtom atom, ScValue *val, bool copyWhole, bool setAsConst) {
+	ScValue *newVal = findProp(atom);
+	if (!newVal) {
+		newVal = new ScValue(_gameRef);
+	} else {
+		newVal->cleanup();
 	}
 
-	return STATUS_OK;
+	newVal->copy(val, copyWhole);
+	newVal->_isConstVar = setAsConst;
+	if (!_valObject) {
+		_valObject = new PropertyMap();
+	}
+	(*_valObject)[atom] = newVal;
+
+	if (_type != VAL_NATIVE) {
+		_type = VAL_OBJECT;
+	}
 }
 
 
@@ -263,31 +298,44 @@ bool ScValue::propExists(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->propExists(name);
 	}
-	_valIter = _valObject.find(name);
 
-	return (_valIter != _valObject.end());
+	return _valObject && _valObject->contains(BaseEngine::instance().getAtomTable()->find(name));
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::propExists(ScAtom atom) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->propExists(atom);
+	}
+
+	return _valObject && _valObject->contains(atom);
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::deleteProps() {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
-		delete(ScValue *)_valIter->_value;
-		_valIter++;
+	if (!_valObject) {
+		return;
+	}
+
+	for (PropertyMap::iterator it = _valObject->begin(); it != _valObject->end(); ++it) {
+		delete it->_value;
 	}
-	_valObject.clear();
+	delete _valObject;
+	_valObject = nullptr;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::CleanProps(bool includingNatives) {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
-		if (!_valIter->_value->_isConstVar && (!_valIter->_value->isNative() || includingNatives)) {
-			_valIter->_value->setNULL();
+	if (!_valObject) {
+		return;
+	}
+
+	for (PropertyMap::iterator it = _valObject->begin(); it != _valObject->end(); ++it) {
+		if (!it->_value->_isConstVar && (!it->_value->isNative() || includingNatives)) {
+			it->_value->setNULL();
 		}
-		_valIter++;
 	}
 }
 
@@ -735,15 +783,17 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 //!!!! ref->native++
 
 	// copy properties
-	if (orig->_type == VAL_OBJECT && orig->_valObject.size() > 0) {
-		orig->_valIter = orig->_valObject.begin();
-		while (orig->_valIter != orig->_valObject.end()) {
-			_valObject[orig->_valIter->_key] = new ScValue(_gameRef);
-			_valObject[orig->_valIter->_key]->copy(orig->_valIter->_value);
-			orig->_valIter++;
+	if (orig->_type == VAL_OBJECT && orig->_valObject && orig->_valObject->size() > 0) {
+		PropertyMap *props = new PropertyMap();
+		for (PropertyMap::iterator it = orig->_valObject->begin(); it != orig->_valObject->end(); ++it) {
+			ScValue *prop = new ScValue(_gameRef);
+			prop->copy(it->_value);
+			(*props)[it->_key] = prop;
 		}
+		_valObject = props;
 	} else {
-		_valObject.clear();
+		delete _valObject;
+		_valObject = nullptr;
 	}
 }
 
@@ -796,16 +846,16 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 
 	int32 size;
 	const char *str;
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
 	if (persistMgr->getIsSaving()) {
-		size = _valObject.size();
+		size = _valObject ? _valObject->size() : 0;
 		persistMgr->transferSint32("", &size);
-		_valIter = _valObject.begin();
-		while (_valIter != _valObject.end()) {
-			str = _valIter->_key.c_str();
-			persistMgr->transferConstChar("", &str);
-			persistMgr->transferPtr("", &_valIter->_value);
-
-			_valIter++;
+		if (_valObject) {
+			for (PropertyMap::iterator it = _valObject->begin(); it != _valObject->end(); ++it) {
+				str = atoms->getName(it->_key);
+				persistMgr->transferConstChar("", &str);
+				persistMgr->transferPtr("", &it->_value);
+			}
 		}
 	} else {
 		ScValue *val = nullptr;
@@ -814,7 +864,10 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			persistMgr->transferConstChar("", &str);
 			persistMgr->transferPtr("", &val);
 
-			_valObject[str] = val;
+			if (!_valObject) {
+				_valObject = new PropertyMap();
+			}
+			(*_valObject)[atoms->intern(str)] = val;
 			delete[] str;
 		}
 	}
@@ -879,14 +932,16 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::saveAsText(BaseDynamicBuffer *buffer, int indent) {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
+	if (!_valObject) {
+		return STATUS_OK;
+	}
+
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
+	for (PropertyMap::iterator it = _valObject->begin(); it != _valObject->end(); ++it) {
 		buffer->putTextIndent(indent, "PROPERTY {\n");
-		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", _valIter->_key.c_str());
-		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", _valIter->_value->getString());
+		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", atoms->getName(it->_key));
+		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", it->_value->getString());
 		buffer->putTextIndent(indent, "}\n\n");
-
-		_valIter++;
 	}
 	return STATUS_OK;
 }
@@ -32,6 +32,8 @@
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
+#include "engines/wintermute/base/scriptables/script_atoms.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -52,6 +54,7 @@ public:
 	void setValue(ScValue *val);
 	bool _persistent;
 	bool propExists(const char *name);
+	bool propExists(ScAtom atom);
 	void copy(ScValue *orig, bool copyWhole = false);
 	void setStringVal(const char *val);
 	TValType getType();
@@ -81,10 +84,15 @@ public:
 	bool isInt();
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
+	bool setProp(ScAtom atom, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	ScValue *getProp(ScAtom atom);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
+	ScValue *findProp(ScAtom atom) const;
+	void storeProp(ScAtom atom, ScValue *val, bool copyWhole, bool setAsConst);
+
 	bool _valBool;
 	int32 _valInt;
 	double _valFloat;
@@ -97,8 +105,9 @@ public:
 	ScValue(BaseGame *inGame, double Val);
 	ScValue(BaseGame *inGame, const char *Val);
 	~ScValue() override;
-	Common::HashMap<Common::String, ScValue *> _valObject;
-	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
+	typedef Common::HashMap<ScAtom, ScValue *> PropertyMap;
+	// Only allocated once a property is set, as most values never get any
+	PropertyMap *_valObject;
 
 	bool setProperty(const char *propName, int32 value);
 	bool setProperty(const char *propName, const char *value);
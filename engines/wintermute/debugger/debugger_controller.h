@@ -105,6 +105,7 @@ public:
 	Common::Path getSourcePath() const;
 	Listing *getListing(Error* &err);
 	void showFps(bool show);
+	Common::String getRenderStats() const;
 	/**
 	 * Inherited from ScriptMonitor
 	 */
@@ -30,6 +30,7 @@ MODULE_OBJS := \
 	base/scriptables/debuggable/debuggable_script.o \
 	base/scriptables/debuggable/debuggable_script_engine.o \
 	base/scriptables/script.o \
+	base/scriptables/script_atoms.o \
 	base/scriptables/script_engine.o \
 	base/scriptables/script_stack.o \
 	base/scriptables/script_value.o \
@@ -187,6 +188,12 @@ MODULE_OBJS += \
 	base/gfx/opengl/shadow_volume_opengl.o \
 	base/gfx/opengl/shadow_volume_opengl_shader.o \
 	base/base_animation_transition_time.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	base/gfx/xmesh_sse2.o
+$(MODULE)/base/gfx/xmesh_sse2.o: CXXFLAGS += -msse2
+endif
 endif
 
 MODULE_DIRS += \
@@ -19,7 +19,6 @@
  *
  */
 
-
 #include "gui/EventRecorder.h"
 
 #ifdef ENABLE_EVENTRECORDER
@@ -42,6 +41,8 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "graphics/thumbnail.h"
 #include "graphics/surface.h"
 #include "graphics/scaler.h"
+#include "common/algorithm.h"
+#include "common/formats/ini-file.h"
 
 namespace GUI {
 
@@ -78,6 +79,11 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_benchmarkStart = 0;
+	_benchmarkLastFrame = 0;
+	_benchmarkStartUserMicros = 0;
+	_benchmarkStartSystemMicros = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -88,6 +94,7 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	finishBenchmark();
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -270,6 +277,11 @@ void EventRecorder::processScreenUpdate() {
 		}
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
+		if (_benchmark) {
+			uint64 now = g_system->getMicros();
+			_benchmarkFrames.push_back((uint32)(now - _benchmarkLastFrame));
+			_benchmarkLastFrame = now;
+		}
 		updateSubsystems();
 		_nextEvent = _playbackFile->getNextEvent();
 		if (_recordMode == kRecorderUpdate) {
@@ -331,6 +343,109 @@ void EventRecorder::switchFastMode() {
 	}
 }
 
+void EventRecorder::startBenchmark(const Common::String &baselineFile) {
+	if (_recordMode != kRecorderPlayback) {
+		return;
+	}
+	_benchmark = true;
+	_benchmarkBaseline = baselineFile;
+	_fastPlayback = true;
+	_benchmarkFrames.clear();
+	_benchmarkStart = _benchmarkLastFrame = g_system->getMicros();
+	uint32 peakMemory;
+	if (!g_system->getProcessUsage(_benchmarkStartUserMicros, _benchmarkStartSystemMicros, peakMemory)) {
+		_benchmarkStartUserMicros = _benchmarkStartSystemMicros = 0;
+	}
+}
+
+static double compareToBaseline(const Common::INIFile &baseline, const char *key, double value) {
+	Common::String baselineValue;
+	if (!baseline.getKey(key, "benchmark", baselineValue) || atof(baselineValue.c_str()) == 0.0) {
+		return 0.0;
+	}
+	double change = (value / atof(baselineValue.c_str()) - 1.0) * 100.0;
+	debugC(1, kDebugLevelEventRec, "benchmark:compare key=%s baseline=%s current=%.3f change=%+.1f%%", key, baselineValue.c_str(), value, change);
+	return change;
+}
+
+void EventRecorder::finishBenchmark() {
+	if (!_benchmark) {
+		return;
+	}
+	_benchmark = false;
+	_fastPlayback = false;
+
+	const uint64 wallMicros = g_system->getMicros() - _benchmarkStart;
+	const uint numFrames = _benchmarkFrames.size();
+	if (numFrames == 0) {
+		warning("benchmark: No frames were played back");
+		return;
+	}
+
+	Common::sort(_benchmarkFrames.begin(), _benchmarkFrames.end());
+	const double wallMs = wallMicros / 1000.0;
+	const double fps = numFrames * 1000000.0 / MAX<uint64>(wallMicros, 1);
+	const double p50 = _benchmarkFrames[numFrames * 50 / 100] / 1000.0;
+	const double p90 = _benchmarkFrames[numFrames * 90 / 100] / 1000.0;
+	const double p99 = _benchmarkFrames[numFrames * 99 / 100] / 1000.0;
+	const double maxFrame = _benchmarkFrames[numFrames - 1] / 1000.0;
+	_benchmarkFrames.clear();
+
+	// CPU time and memory are only reported where the backend provides them
+	uint64 userMicros, systemMicros;
+	uint32 peakMemory;
+	const bool haveUsage = g_system->getProcessUsage(userMicros, systemMicros, peakMemory);
+	const double cpuMs = haveUsage ? (userMicros - _benchmarkStartUserMicros + systemMicros - _benchmarkStartSystemMicros) / 1000.0 : 0.0;
+
+	debugC(1, kDebugLevelEventRec, "benchmark:result frames=%u wall_ms=%.1f fps=%.1f p50_ms=%.3f p90_ms=%.3f p99_ms=%.3f max_ms=%.3f",
+	       numFrames, wallMs, fps, p50, p90, p99, maxFrame);
+	if (haveUsage) {
+		debugC(1, kDebugLevelEventRec, "benchmark:usage cpu_ms=%.1f peak_memory_kb=%u", cpuMs, peakMemory);
+	}
+
+	if (_benchmarkBaseline.empty()) {
+		return;
+	}
+
+	const Common::Path baselinePath(_benchmarkBaseline, Common::Path::kNativeSeparator);
+	Common::INIFile baseline;
+	if (baseline.loadFromFile(baselinePath)) {
+		// Only the frame count is expected to match exactly, as the playback is deterministic
+		Common::String baselineFrames;
+		if (baseline.getKey("frames", "benchmark", baselineFrames) && (uint)atoi(baselineFrames.c_str()) != numFrames) {
+			warning("benchmark: Played back %u frames, but the baseline has %s", numFrames, baselineFrames.c_str());
+		}
+		compareToBaseline(baseline, "wall_ms", wallMs);
+		compareToBaseline(baseline, "p50_ms", p50);
+		compareToBaseline(baseline, "p99_ms", p99);
+		if (haveUsage) {
+			compareToBaseline(baseline, "cpu_ms", cpuMs);
+			compareToBaseline(baseline, "peak_memory_kb", peakMemory);
+		}
+		const double fpsChange = compareToBaseline(baseline, "fps", fps);
+		if (fpsChange < -5.0) {
+			warning("benchmark: Frame rate regressed by %.1f%% compared to the baseline", -fpsChange);
+		}
+	} else {
+		baseline.setKey("frames", "benchmark", Common::String::format("%u", numFrames));
+		baseline.setKey("wall_ms", "benchmark", Common::String::format("%.1f", wallMs));
+		baseline.setKey("fps", "benchmark", Common::String::format("%.1f", fps));
+		baseline.setKey("p50_ms", "benchmark", Common::String::format("%.3f", p50));
+		baseline.setKey("p90_ms", "benchmark", Common::String::format("%.3f", p90));
+		baseline.setKey("p99_ms", "benchmark", Common::String::format("%.3f", p99));
+		baseline.setKey("max_ms", "benchmark", Common::String::format("%.3f", maxFrame));
+		if (haveUsage) {
+			baseline.setKey("cpu_ms", "benchmark", Common::String::format("%.1f", cpuMs));
+			baseline.setKey("peak_memory_kb", "benchmark", Common::String::format("%u", peakMemory));
+		}
+		if (baseline.saveToFile(baselinePath)) {
+			debugC(1, kDebugLevelEventRec, "benchmark:action=\"Baseline written\" filename=%s", _benchmarkBaseline.c_str());
+		} else {
+			warning("benchmark: Could not write the baseline to '%s'", _benchmarkBaseline.c_str());
+		}
+	}
+}
+
 void EventRecorder::togglePause() {
 	RecordMode oldState;
 	switch (_recordMode) {
@@ -699,6 +814,9 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -716,6 +834,9 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -187,6 +187,15 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/**
+	 * Play back as fast as possible, without drawing the control panel, and
+	 * time every frame. The results are compared against @p baselineFile if
+	 * it exists, or written to it otherwise.
+	 */
+	void startBenchmark(const Common::String &baselineFile);
+	/** Report the benchmark results, if a benchmark is running. */
+	void finishBenchmark();
+
 private:
 	bool pollEvent(Common::Event &ev) override;
 	bool notifyEvent(const Common::Event &event) override;
@@ -249,6 +258,14 @@ private:
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	bool _benchmark;
+	Common::String _benchmarkBaseline;
+	uint64 _benchmarkStart;
+	uint64 _benchmarkLastFrame;
+	uint64 _benchmarkStartUserMicros;
+	uint64 _benchmarkStartSystemMicros;
+	Common::Array<uint32> _benchmarkFrames;
 };
 
 } // End of namespace GUI
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -81,6 +82,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+#ifdef USE_PROFILER
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -841,6 +845,36 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef USE_PROFILER
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc == 1) {
+		const Common::Array<Common::Profiler::ZoneStats> &zones = profiler.getLastFrameZones();
+		debugPrintf("Last frame: %.2f ms\n", profiler.getLastFrameMicros() / 1000.0f);
+		for (uint i = 0; i < zones.size(); i++) {
+			debugPrintf("  %-32s %4u calls, %8.3f ms total, %8.3f ms max\n", zones[i].name,
+			            zones[i].calls, zones[i].totalMicros / 1000.0f, zones[i].maxMicros / 1000.0f);
+		}
+		const Common::Array<Common::Profiler::CounterValue> &counters = profiler.getLastFrameCounters();
+		for (uint i = 0; i < counters.size(); i++)
+			debugPrintf("  %-32s %lld\n", counters[i].name, (long long)counters[i].value);
+	} else if (!strcmp(argv[1], "start")) {
+		profiler.startTrace();
+		debugPrintf("Started tracing\n");
+	} else if (!strcmp(argv[1], "stop") && argc == 3) {
+		if (profiler.stopTrace(Common::Path(argv[2], Common::Path::kNativeSeparator)))
+			debugPrintf("Trace written to '%s'\n", argv[2]);
+		else
+			debugPrintf("Failed to write the trace to '%s'\n", argv[2]);
+	} else {
+		debugPrintf("Usage: %s [start | stop <file>]\n", argv[0]);
+		debugPrintf("Without arguments, prints the timings of the last frame\n");
+	}
+	return true;
+}
+#endif
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -176,6 +176,15 @@ bool LauncherFilterMatcher(void *boss, int idx, const Common::U32String &item, c
 	return invert ? !result : result;
 }
 
+bool LauncherFilterSubstringCheck(void *boss, const Common::U32String &token) {
+	// Anything but plain words gets interpreted by LauncherFilterMatcher
+	for (uint i = 0; i < token.size(); ++i) {
+		if (token[i] == '!' || token[i] == ':' || token[i] == '=' || token[i] == '~')
+			return false;
+	}
+	return true;
+}
+
 LauncherDialog::LauncherDialog(const Common::String &dialogName)
 	: Dialog(dialogName), _title(dialogName), _browser(nullptr),
 	_loadDialog(nullptr), _searchClearButton(nullptr), _searchDesc(nullptr),
@@ -1115,7 +1124,8 @@ void LauncherSimple::build() {
 	_list->setEditable(false);
 	_list->enableDictionarySelect(true);
 	_list->setNumberingMode(kListNumberingOff);
-	_list->setFilterMatcher(LauncherFilterMatcher, this);
+	_list->setFilterMatcher(LauncherFilterMatcher, this, LauncherFilterSubstringCheck);
+	_list->enableFilterIndex(true);
 
 	// Populate the list
 	updateListing();
@@ -1574,11 +1584,17 @@ void LauncherGrid::updateListing(int selPos) {
 	// Retrieve a list of all games defined in the config file
 	_domains.clear();
 	const Common::ConfigManager::DomainMap &domains = ConfMan.getGameDomains();
+	// Checking that the game directories exist hits the filesystem once per
+	// game, so large libraries skip it, like in the list view
+	const int numEntries = ConfMan.getInt("gui_list_max_scan_entries");
+	const bool scanEntries = numEntries == -1 ? true : ((int)domains.size() <= numEntries);
 
 	// Turn it into a sorted list of entries
 	Common::Array<LauncherEntry> domainList = generateEntries(domains);
 
 	Common::Array<GridItemInfo> gridList;
+	gridList.reserve(domainList.size());
+	_domains.reserve(domainList.size());
 
 	int k = 0;
 	for (Common::Array<LauncherEntry>::const_iterator iter = domainList.begin(); iter != domainList.end(); ++iter) {
@@ -1593,7 +1609,10 @@ void LauncherGrid::updateListing(int selPos) {
 		iter->domain->tryGetVal("language", language);
 		iter->domain->tryGetVal("platform", platform);
 		iter->domain->tryGetVal("extra", extra);
-		valid_path = (!iter->domain->tryGetVal("path", path) || !Common::FSNode(Common::Path::fromConfig(path)).isDirectory()) ? false : true;
+		if (!iter->domain->tryGetVal("path", path))
+			valid_path = false;
+		else
+			valid_path = !scanEntries || Common::FSNode(Common::Path::fromConfig(path)).isDirectory();
 		gridList.push_back(GridItemInfo(k++, engineid, gameid, iter->description, iter->title, extra, Common::parseLanguage(language), Common::parsePlatform(platform), valid_path));
 		_domains.push_back(iter->key);
 	}
@@ -1653,6 +1672,8 @@ void LauncherGrid::build() {
 
 	// Add list with game titles
 	_grid = new GridWidget(this, "LauncherGrid.IconArea");
+	// The grid picks up asynchronously loaded thumbnails when tickled
+	setTickleWidget(_grid);
 	// Populate the list
 	updateListing();
 
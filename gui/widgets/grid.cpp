@@ -23,6 +23,7 @@
 #include "common/file.h"
 #include "common/language.h"
 #include "common/platform.h"
+#include "common/timer.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 
@@ -389,6 +390,17 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 
 #pragma mark -
 
+enum {
+	// Lower bound of the thumbnail cache size, in bytes. The budget grows so that
+	// it can always hold the thumbnails of three screens worth of items.
+	kThumbnailCacheMinBudget = 16 * 1024 * 1024,
+	// Time a single run of the thumbnail loader may spend decoding, in milliseconds.
+	kThumbnailLoaderTimeSlice = 5
+};
+
+Common::Array<GridWidget *> GridWidget::s_thumbnailLoaderGrids;
+bool GridWidget::s_thumbnailLoaderInstalled = false;
+
 GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	: ContainerWidget(boss, name), CommandSender(boss) {
 
@@ -434,13 +446,21 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+
+	_thumbnailCacheSize = 0;
+	_thumbnailCacheBudget = kThumbnailCacheMinBudget;
+	registerThumbnailLoader(true);
+
+	setFlags(WIDGET_WANT_TICKLE);
 }
 
 GridWidget::~GridWidget() {
+	registerThumbnailLoader(false);
+
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
-	unloadSurfaces(_loadedSurfaces);
+	unloadThumbnails();
 	delete _disabledIconOverlay;
 	_gridItems.clear();
 	_dataEntryList.clear();
@@ -457,10 +477,66 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 	surfaces.clear();
 }
 
+void GridWidget::unloadThumbnails() {
+	Common::StackLock lock(_thumbnailMutex);
+
+	for (Common::HashMap<Common::String, ThumbnailCacheEntry>::iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+		delete i->_value.surface;
+	}
+	_loadedSurfaces.clear();
+	_thumbnailLRU.clear();
+	_thumbnailCacheSize = 0;
+
+	// Thumbnails in flight were scaled for the old size, drop them as well
+	for (uint i = 0; i < _decodedThumbnails.size(); ++i) {
+		delete _decodedThumbnails[i].surface;
+	}
+	_decodedThumbnails.clear();
+	_pendingThumbnails.clear();
+	_requestedThumbnails.clear();
+}
+
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+
+	Common::HashMap<Common::String, ThumbnailCacheEntry>::iterator entry = _loadedSurfaces.find(name);
+	if (entry == _loadedSurfaces.end())
+		return nullptr;
+
+	// Move the thumbnail to the front of the LRU list
+	_thumbnailLRU.erase(entry->_value.lruPos);
+	_thumbnailLRU.push_front(name);
+	entry->_value.lruPos = _thumbnailLRU.begin();
+
+	return entry->_value.surface;
+}
+
+void GridWidget::addThumbnailToCache(const Common::String &path, const Graphics::ManagedSurface *surface) {
+	if (_loadedSurfaces.contains(path)) {
+		delete surface;
+		return;
+	}
+
+	ThumbnailCacheEntry entry;
+	entry.surface = surface;
+	entry.size = surface ? surface->pitch * surface->h : 0;
+	_thumbnailLRU.push_front(path);
+	entry.lruPos = _thumbnailLRU.begin();
+	_loadedSurfaces[path] = entry;
+	_thumbnailCacheSize += entry.size;
+
+	// Evict the least recently used thumbnails. Items keep their own copy of
+	// the thumbnail, so evicting the ones on screen is harmless.
+	while (_thumbnailCacheSize > _thumbnailCacheBudget && _thumbnailLRU.begin() != --_thumbnailLRU.end()) {
+		const Common::String oldest = _thumbnailLRU.back();
+		_thumbnailLRU.pop_back();
+
+		ThumbnailCacheEntry &old = _loadedSurfaces[oldest];
+		_thumbnailCacheSize -= old.size;
+		delete old.surface;
+		_loadedSurfaces.erase(oldest);
+	}
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode) {
@@ -573,18 +649,14 @@ void GridWidget::sortGroups() {
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
+		const Common::U32StringArray tokens = tok.split();
 
 		_sortedEntryList.clear();
 
-		for (GridItemInfo *i = _dataEntryList.begin(); i != _dataEntryList.end(); ++i, ++n) {
-			tmp = i->title;
-			tmp.toLowercase();
+		for (GridItemInfo *i = _dataEntryList.begin(); i != _dataEntryList.end(); ++i) {
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+			for (uint t = 0; t < tokens.size(); ++t) {
+				if (!i->filterTitle.contains(tokens[t])) {
 					matches = false;
 					break;
 				}
@@ -683,40 +755,201 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 void GridWidget::reloadThumbnails() {
 	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
 	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
-	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
-		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
-			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
-				}
+	collectDecodedThumbnails();
+
+	// Besides the visible entries, prefetch the thumbnails of one screen above and below,
+	// so that scrolling does not have to wait for them
+	const int prefetch = _visibleEntryList.size();
+	const int first = MAX(_firstVisibleItem - prefetch, 0);
+	const int last = MIN(_lastVisibleItem + prefetch, (int)_sortedEntryList.size() - 1);
+
+	const uint32 windowBytes = (uint32)(last - first + 1) * thumbnailWidth * thumbnailHeight * g_system->getOverlayFormat().bytesPerPixel;
+	_thumbnailCacheBudget = MAX<uint32>(kThumbnailCacheMinBudget, windowBytes * 2);
+
+	Common::Array<ThumbnailRequest> requests;
+	for (int pass = 0; pass < 2; ++pass) {
+		// Visible entries go first, then the ones around them
+		const int from = (pass == 0) ? _firstVisibleItem : first;
+		const int to = (pass == 0) ? MIN(_lastVisibleItem, last) : last;
+		for (int i = from; i <= to; ++i) {
+			if (pass == 1 && i == _firstVisibleItem) {
+				i = _lastVisibleItem;
+				continue;
 			}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+			const GridItemInfo *entry = _sortedEntryList[i];
+			if (entry->thumbPath.empty())
+				continue;
 
-				if (path != entry->thumbPath) {
-					_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
-				}
+			if (_loadedSurfaces.contains(entry->thumbPath)) {
+				filenameToSurface(entry->thumbPath);
+				continue;
+			}
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
+			if (_requestedThumbnails.contains(entry->thumbPath))
+				continue;
+
+			ThumbnailRequest request;
+			request.thumbPath = entry->thumbPath;
+			request.engineid = entry->engineid;
+			request.gameid = entry->gameid;
+			request.width = thumbnailWidth;
+			request.height = thumbnailHeight;
+			request.surface = nullptr;
+			requests.push_back(request);
+		}
+	}
+
+	if (!g_system->getTimerManager()) {
+		// No timer available, decode the visible thumbnails right here
+		for (uint i = 0; i < requests.size(); ++i) {
+			const Common::String &path = requests[i].thumbPath;
+			if (!_loadedSurfaces.contains(path)) {
+				decodeThumbnail(requests[i]);
+				addThumbnailToCache(path, requests[i].surface);
 			}
 		}
+		return;
 	}
+
+	// Replace the queued requests, those which scrolled out of range are dropped
+	{
+		Common::StackLock lock(_thumbnailMutex);
+		for (uint i = 0; i < _pendingThumbnails.size(); ++i) {
+			_requestedThumbnails.erase(_pendingThumbnails[i].thumbPath);
+		}
+		_pendingThumbnails.clear();
+		for (uint i = 0; i < requests.size(); ++i) {
+			if (_requestedThumbnails.contains(requests[i].thumbPath))
+				continue;
+			_requestedThumbnails[requests[i].thumbPath] = true;
+			_pendingThumbnails.push_back(requests[i]);
+		}
+	}
+
+	updateThumbnailLoader();
+}
+
+void GridWidget::collectDecodedThumbnails() {
+	Common::Array<ThumbnailRequest> decoded;
+	{
+		Common::StackLock lock(_thumbnailMutex);
+		if (_decodedThumbnails.empty())
+			return;
+		decoded.swap(_decodedThumbnails);
+	}
+
+	// Stop the loader once all queued thumbnails have been decoded
+	updateThumbnailLoader();
+
+	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
+	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+
+	for (uint i = 0; i < decoded.size(); ++i) {
+		_requestedThumbnails.erase(decoded[i].thumbPath);
+		// Drop thumbnails which were requested before the last resize
+		if (decoded[i].width != thumbnailWidth || decoded[i].height != thumbnailHeight) {
+			delete decoded[i].surface;
+			continue;
+		}
+		addThumbnailToCache(decoded[i].thumbPath, decoded[i].surface);
+	}
+
+	// Show the new thumbnails on the items which are waiting for them
+	for (Common::Array<GridItemWidget *>::iterator i = _gridItems.begin(); i != _gridItems.end(); ++i) {
+		if ((*i)->isVisible())
+			(*i)->update();
+	}
+}
+
+void GridWidget::decodeThumbnail(ThumbnailRequest &request) {
+	Common::String path = Common::String::format("icons/%s-%s.png", request.engineid.c_str(), request.gameid.c_str());
+	Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+	if (!surf) {
+		path = Common::String::format("icons/%s.png", request.engineid.c_str());
+		surf = loadSurfaceFromFile(path);
+	}
+
+	request.surface = nullptr;
+	if (surf) {
+		const Graphics::ManagedSurface *scSurf = scaleGfx(surf, request.width, request.height, true);
+		if (scSurf != surf) {
+			surf->free();
+			delete surf;
+		}
+		request.surface = const_cast<Graphics::ManagedSurface *>(scSurf);
+	}
+}
+
+void GridWidget::decodePendingThumbnails() {
+	const uint32 startTime = g_system->getMillis();
+
+	do {
+		ThumbnailRequest request;
+		{
+			Common::StackLock lock(_thumbnailMutex);
+			if (_pendingThumbnails.empty())
+				return;
+			request = _pendingThumbnails.front();
+			_pendingThumbnails.remove_at(0);
+		}
+
+		decodeThumbnail(request);
+
+		Common::StackLock lock(_thumbnailMutex);
+		_decodedThumbnails.push_back(request);
+	} while (g_system->getMillis() - startTime < kThumbnailLoaderTimeSlice);
+}
+
+void GridWidget::thumbnailLoaderProc(void *refCon) {
+	for (uint i = 0; i < s_thumbnailLoaderGrids.size(); ++i) {
+		s_thumbnailLoaderGrids[i]->decodePendingThumbnails();
+	}
+}
+
+void GridWidget::updateThumbnailLoader() {
+	// A single timer callback serves all grids, and only runs while one of
+	// them has thumbnails queued. This is only called from the GUI thread.
+	bool pending = false;
+	for (uint i = 0; i < s_thumbnailLoaderGrids.size() && !pending; ++i) {
+		Common::StackLock lock(s_thumbnailLoaderGrids[i]->_thumbnailMutex);
+		pending = !s_thumbnailLoaderGrids[i]->_pendingThumbnails.empty();
+	}
+
+	Common::TimerManager *timer = g_system->getTimerManager();
+	if (!timer || pending == s_thumbnailLoaderInstalled)
+		return;
+
+	if (pending)
+		s_thumbnailLoaderInstalled = timer->installTimerProc(&thumbnailLoaderProc, 10000, nullptr, "GridThumbnailLoader");
+	else {
+		timer->removeTimerProc(&thumbnailLoaderProc);
+		s_thumbnailLoaderInstalled = false;
+	}
+}
+
+void GridWidget::registerThumbnailLoader(bool add) {
+	// The timer callback is removed while the list of grids changes, which
+	// also waits for a running callback to finish.
+	Common::TimerManager *timer = g_system->getTimerManager();
+	if (s_thumbnailLoaderInstalled) {
+		timer->removeTimerProc(&thumbnailLoaderProc);
+		s_thumbnailLoaderInstalled = false;
+	}
+
+	if (add) {
+		s_thumbnailLoaderGrids.push_back(this);
+	} else {
+		for (uint i = 0; i < s_thumbnailLoaderGrids.size(); ++i) {
+			if (s_thumbnailLoaderGrids[i] == this) {
+				s_thumbnailLoaderGrids.remove_at(i);
+				break;
+			}
+		}
+	}
+
+	updateThumbnailLoader();
 }
 
 void GridWidget::loadFlagIcons() {
@@ -931,6 +1164,10 @@ void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	}
 }
 
+void GridWidget::handleTickle() {
+	collectDecodedThumbnails();
+}
+
 void GridWidget::calcInnerHeight() {
 	int row = 0;
 	int col = 0;
@@ -988,9 +1225,14 @@ void GridWidget::calcEntrySizes() {
 		} else {
 			int titleRows;
 			if (_isTitlesVisible) {
-				Common::Array<Common::U32String> titleLines;
-				g_gui.getFont().wordWrapText(entry->title, _gridItemWidth, titleLines);
-				titleRows = MIN(2U, titleLines.size());
+				// Word wrapping is expensive for large lists, only redo it when the width changed
+				if (entry->titleRowsWidth != _gridItemWidth) {
+					Common::Array<Common::U32String> titleLines;
+					g_gui.getFont().wordWrapText(entry->title, _gridItemWidth, titleLines);
+					entry->titleRows = MIN(2U, titleLines.size());
+					entry->titleRowsWidth = _gridItemWidth;
+				}
+				titleRows = entry->titleRows;
 			} else {
 				titleRows = 0;
 			}
@@ -1045,7 +1287,7 @@ void GridWidget::reflowLayout() {
 		unloadSurfaces(_extraIcons);
 		unloadSurfaces(_platformIcons);
 		unloadSurfaces(_languageIcons);
-		unloadSurfaces(_loadedSurfaces);
+		unloadThumbnails();
 		if (_disabledIconOverlay)
 			_disabledIconOverlay->free();
 		reloadThumbnails();
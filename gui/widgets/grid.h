@@ -24,6 +24,8 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include "common/str.h"
 
 #include "image/bmp.h"
@@ -60,17 +62,25 @@ struct GridItemInfo {
 	Common::String		attribute;
 	Common::Language	language;
 	Common::Platform 	platform;
+	// Lowercased title, used for filtering
+	Common::U32String	filterTitle;
 
 	int32				x, y, w, h;
+	// Number of title lines, cached for the item width it was computed for
+	int32				titleRows, titleRowsWidth;
 
 	GridItemInfo(int id, const Common::String &eid, const Common::String &gid, const Common::String &t,
 		const Common::String &d, const Common::String &e, Common::Language l, Common::Platform p, bool v)
-		: entryID(id), gameid(gid), engineid(eid), title(t), description(d), extra(e), language(l), platform(p), validEntry(v), isHeader(false) {
+		: entryID(id), gameid(gid), engineid(eid), title(t), description(d), extra(e), language(l), platform(p), validEntry(v), isHeader(false),
+		x(0), y(0), w(0), h(0), titleRows(0), titleRowsWidth(-1) {
 		thumbPath = Common::String::format("icons/%s-%s.png", engineid.c_str(), gameid.c_str());
+		filterTitle = title.decode();
+		filterTitle.toLowercase();
 	}
 
 	GridItemInfo(const Common::String &groupHeader, int groupID) : title(groupHeader), description(groupHeader),
-		isHeader(true), validEntry(true), entryID(groupID), language(Common::UNK_LANG), platform(Common::kPlatformUnknown) {
+		isHeader(true), validEntry(true), entryID(groupID), language(Common::UNK_LANG), platform(Common::kPlatformUnknown),
+		x(0), y(0), w(0), h(0), titleRows(0), titleRowsWidth(-1) {
 		thumbPath = Common::String("");
 	}
 };
@@ -102,8 +112,36 @@ protected:
 	Common::HashMap<int, const Graphics::ManagedSurface *> _languageIcons;
 	Common::HashMap<int, const Graphics::ManagedSurface *> _extraIcons;
 	Graphics::ManagedSurface *_disabledIconOverlay;
-	// Images are mapped by filename -> surface.
-	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+
+	struct ThumbnailCacheEntry {
+		const Graphics::ManagedSurface *surface;
+		uint32 size;
+		Common::List<Common::String>::iterator lruPos;
+	};
+
+	struct ThumbnailRequest {
+		Common::String thumbPath;
+		Common::String engineid;
+		Common::String gameid;
+		int width, height;
+		Graphics::ManagedSurface *surface;
+	};
+
+	// Thumbnails are mapped by filename -> surface, a null surface marks an unavailable image.
+	// The cache is limited to _thumbnailCacheBudget bytes, evicting the least recently used
+	// thumbnails (the back of _thumbnailLRU) first.
+	Common::HashMap<Common::String, ThumbnailCacheEntry> _loadedSurfaces;
+	Common::List<Common::String>	_thumbnailLRU;
+	uint32							_thumbnailCacheSize;
+	uint32							_thumbnailCacheBudget;
+
+	// Thumbnails are decoded and scaled by a timer callback, off the GUI thread when the
+	// backend runs timers on their own thread. The request queues are shared with it.
+	Common::Mutex						_thumbnailMutex;
+	Common::Array<ThumbnailRequest>		_pendingThumbnails;
+	Common::Array<ThumbnailRequest>		_decodedThumbnails;
+	// Thumbnails queued for decoding and not yet added to the cache. Only used by the GUI thread.
+	Common::HashMap<Common::String, bool>	_requestedThumbnails;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
@@ -170,6 +208,7 @@ public:
 
 	template<typename T>
 	void unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurface *> &surfaces);
+	void unloadThumbnails();
 
 	const Graphics::ManagedSurface *filenameToSurface(const Common::String &name);
 	const Graphics::ManagedSurface *languageToSurface(Common::Language languageCode);
@@ -194,6 +233,7 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	void collectDecodedThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -215,6 +255,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -225,6 +266,17 @@ public:
 
 	void setSelected(int id);
 	void setFilter(const Common::U32String &filter);
+
+private:
+	static Common::Array<GridWidget *> s_thumbnailLoaderGrids;
+	static bool s_thumbnailLoaderInstalled;
+
+	static void thumbnailLoaderProc(void *refCon);
+	static void updateThumbnailLoader();
+	void registerThumbnailLoader(bool add);
+	static void decodeThumbnail(ThumbnailRequest &request);
+	void decodePendingThumbnails();
+	void addThumbnailToCache(const Common::String &path, const Graphics::ManagedSurface *surface);
 };
 
 /* GridItemWidget */
@@ -70,6 +70,9 @@ ListWidget::ListWidget(Dialog *boss, const Common::String &name, const Common::U
 
 	_filterMatcher = ListWidgetDefaultMatcher;
 	_filterMatcherArg = nullptr;
+	_filterSubstringCheck = nullptr;
+	_filterIndexEnabled = false;
+	_filterResultsValid = false;
 
 	_lastRead = -1;
 
@@ -112,6 +115,9 @@ ListWidget::ListWidget(Dialog *boss, int x, int y, int w, int h, bool scale, con
 
 	_filterMatcher = ListWidgetDefaultMatcher;
 	_filterMatcherArg = nullptr;
+	_filterSubstringCheck = nullptr;
+	_filterIndexEnabled = false;
+	_filterResultsValid = false;
 
 	_lastRead = -1;
 
@@ -131,12 +137,43 @@ void ListWidget::copyListData(const Common::U32StringArray &list) {
 
 	_dataList.clear();
 	_cleanedList.clear();
+	_filterIndex.clear();
+	_filterResultsValid = false;
 
 	for (uint i = 0; i < list.size(); ++i) {
 		stripped = stripGUIformatting(list[i]);
 
 		_dataList.push_back(ListData(list[i], stripped));
 		_cleanedList.push_back(stripped);
+		addToFilterIndex(i);
+	}
+}
+
+void ListWidget::enableFilterIndex(bool enable) {
+	if (_filterIndexEnabled == enable)
+		return;
+
+	_filterIndexEnabled = enable;
+	_filterIndex.clear();
+	for (uint i = 0; i < _dataList.size(); ++i)
+		addToFilterIndex(i);
+}
+
+static uint32 filterTrigram(const Common::U32String &str, uint pos) {
+	// Collisions only add candidates, which get rejected by the matcher later on
+	return (str[pos] * 65599 + str[pos + 1]) * 65599 + str[pos + 2];
+}
+
+void ListWidget::addToFilterIndex(int idx) {
+	if (!_filterIndexEnabled)
+		return;
+
+	const Common::U32String &str = _dataList[idx].lower;
+	for (uint i = 0; i + 2 < str.size(); ++i) {
+		Common::Array<int> &items = _filterIndex[filterTrigram(str, i)];
+		// Items are added in ascending order, so duplicates are always at the end
+		if (items.empty() || items.back() != idx)
+			items.push_back(idx);
 	}
 }
 
@@ -215,6 +252,8 @@ void ListWidget::append(const Common::String &s) {
 	_dataList.push_back(ListData(s, stripped));
 	_cleanedList.push_back(stripped);
 	_list.push_back(s);
+	addToFilterIndex(_dataList.size() - 1);
+	_filterResultsValid = false;
 
 	setFilter(_filter, false);
 
@@ -745,6 +784,130 @@ void ListWidget::reflowLayout() {
 	}
 }
 
+bool ListWidget::isSubstringToken(const Common::U32String &token) const {
+	if (_filterSubstringCheck)
+		return _filterSubstringCheck(_filterMatcherArg, token);
+	return _filterMatcher == ListWidgetDefaultMatcher;
+}
+
+bool ListWidget::isNarrowedFilter(const Common::U32String &previousFilter, const Common::U32StringArray &tokens, uint &firstNewToken) const {
+	// The filter only narrows the current results if it was extended by typing at its end,
+	// and all the tokens which changed or were added are plain substring matches.
+	Common::U32StringTokenizer tok(previousFilter);
+	const Common::U32StringArray previousTokens = tok.split();
+	if (previousTokens.empty() || tokens.size() < previousTokens.size())
+		return false;
+
+	const uint last = previousTokens.size() - 1;
+	for (uint i = 0; i < last; ++i) {
+		if (tokens[i] != previousTokens[i])
+			return false;
+	}
+
+	if (tokens[last] == previousTokens[last]) {
+		firstNewToken = last + 1;
+	} else if (tokens[last].substr(0, previousTokens[last].size()) == previousTokens[last] && isSubstringToken(previousTokens[last])) {
+		firstNewToken = last;
+	} else {
+		return false;
+	}
+
+	for (uint i = firstNewToken; i < tokens.size(); ++i) {
+		if (!isSubstringToken(tokens[i]))
+			return false;
+	}
+	return true;
+}
+
+bool ListWidget::lookupFilterIndex(const Common::U32StringArray &tokens, Common::Array<int> &candidates) const {
+	if (!_filterIndexEnabled)
+		return false;
+
+	bool found = false;
+	for (uint t = 0; t < tokens.size(); ++t) {
+		const Common::U32String &token = tokens[t];
+		if (token.size() < 3 || !isSubstringToken(token))
+			continue;
+
+		for (uint i = 0; i + 2 < token.size(); ++i) {
+			FilterIndex::const_iterator items = _filterIndex.find(filterTrigram(token, i));
+			if (items == _filterIndex.end()) {
+				candidates.clear();
+				return true;
+			}
+
+			if (!found) {
+				candidates = items->_value;
+				found = true;
+				continue;
+			}
+
+			// Intersect the two ascending lists
+			Common::Array<int> intersection;
+			const Common::Array<int> &other = items->_value;
+			uint a = 0, b = 0;
+			while (a < candidates.size() && b < other.size()) {
+				if (candidates[a] < other[b]) {
+					++a;
+				} else if (other[b] < candidates[a]) {
+					++b;
+				} else {
+					intersection.push_back(candidates[a]);
+					++a;
+					++b;
+				}
+			}
+			candidates.swap(intersection);
+		}
+	}
+
+	return found;
+}
+
+void ListWidget::applyFilter(const Common::U32String &previousFilter) {
+	// Restrict the list to everything which matches all tokens in _filter, ignoring case.
+	Common::U32StringTokenizer tok(_filter);
+	const Common::U32StringArray tokens = tok.split();
+
+	// When the filter got narrowed down, only the current results need to be
+	// checked, and only against the new tokens. Otherwise the filter index
+	// may provide a set of candidates.
+	Common::Array<int> candidates;
+	uint firstToken = 0;
+	bool useCandidates = false;
+	if (_filterResultsValid && !previousFilter.empty() && isNarrowedFilter(previousFilter, tokens, firstToken)) {
+		candidates.swap(_filterResults);
+		useCandidates = true;
+	} else {
+		firstToken = 0;
+		useCandidates = lookupFilterIndex(tokens, candidates);
+	}
+
+	_list.clear();
+	_listIndex.clear();
+
+	const uint count = useCandidates ? candidates.size() : _dataList.size();
+	for (uint c = 0; c < count; ++c) {
+		const int n = useCandidates ? candidates[c] : c;
+		const ListData &data = _dataList[n];
+		bool matches = true;
+		for (uint t = firstToken; t < tokens.size(); ++t) {
+			if (!_filterMatcher(_filterMatcherArg, n, data.lower, tokens[t])) {
+				matches = false;
+				break;
+			}
+		}
+
+		if (matches) {
+			_list.push_back(data.orig);
+			_listIndex.push_back(n);
+		}
+	}
+
+	_filterResults = _listIndex;
+	_filterResultsValid = true;
+}
+
 void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	// FIXME: This method does not deal correctly with edit mode!
 	// Until we fix that, let's make sure it isn't called while editing takes place
@@ -756,6 +919,7 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	const Common::U32String previousFilter = _filter;
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -767,33 +931,9 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 			_list.push_back(_dataList[i].orig);
 
 		_listIndex.clear();
+		_filterResultsValid = false;
 	} else {
-		// Restrict the list to everything which matches all tokens in _filter, ignoring case.
-
-		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
-
-		_list.clear();
-		_listIndex.clear();
-
-		for (auto i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = i->clean;
-			tmp.toLowercase();
-			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!_filterMatcher(_filterMatcherArg, n, tmp, tok.nextToken())) {
-					matches = false;
-					break;
-				}
-			}
-
-			if (matches) {
-				_list.push_back(i->orig);
-				_listIndex.push_back(n);
-			}
-		}
+		applyFilter(previousFilter);
 	}
 
 	_currentPos = 0;
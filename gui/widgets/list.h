@@ -49,12 +49,19 @@ enum {
 class ListWidget : public EditableWidget {
 public:
 	typedef bool (*FilterMatcher)(void *arg, int idx, const Common::U32String &item, const Common::U32String &token);
+	/**
+	 * Tells whether a FilterMatcher matches the given (lowercase) token as a plain
+	 * substring of the item. Only such tokens can be narrowed down incrementally
+	 * and be looked up in the filter index.
+	 */
+	typedef bool (*FilterSubstringCheck)(void *arg, const Common::U32String &token);
 
 	struct ListData {
 		Common::U32String orig;
 		Common::U32String clean;
+		Common::U32String lower;
 
-		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; }
+		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; lower = c; lower.toLowercase(); }
 	};
 
 	typedef Common::Array<ListData> ListDataArray;
@@ -85,6 +92,9 @@ protected:
 	int				_scrollBarWidth;
 
 	Common::U32String	_filter;
+	/// Indices into _dataList matching _filter, kept apart from _listIndex which subclasses may refill
+	Common::Array<int>	_filterResults;
+	bool			_filterResultsValid;
 	bool			_quickSelect;
 	bool			_dictionarySelect;
 
@@ -96,6 +106,12 @@ protected:
 
 	FilterMatcher	_filterMatcher;
 	void			*_filterMatcherArg;
+	FilterSubstringCheck	_filterSubstringCheck;
+
+	/// Trigram -> indices into _dataList (ascending) of the items containing it
+	typedef Common::HashMap<uint32, Common::Array<int> > FilterIndex;
+	bool			_filterIndexEnabled;
+	FilterIndex		_filterIndex;
 
 	Common::Array<bool>	_listSelected;
 
@@ -131,7 +147,11 @@ public:
 	bool isEditable() const						{ return _editable; }
 	void setEditable(bool editable)				{ _editable = editable; }
 	void setEditColor(ThemeEngine::FontColor color) { _editColor = color; }
-	void setFilterMatcher(FilterMatcher matcher, void *arg) { _filterMatcher = matcher; _filterMatcherArg = arg; }
+	void setFilterMatcher(FilterMatcher matcher, void *arg, FilterSubstringCheck substringCheck = nullptr) {
+		_filterMatcher = matcher; _filterMatcherArg = arg; _filterSubstringCheck = substringCheck;
+	}
+	/// Keep a trigram index of the items to speed up filtering large lists
+	void enableFilterIndex(bool enable);
 
 	void appendToSelectedList(bool selected) { _listSelected.push_back(selected); }
 	void clearSelectedList() { _listSelected.clear(); }
@@ -176,6 +196,13 @@ protected:
 
 	void copyListData(const Common::U32StringArray &list);
 
+	/// Fill _list and _listIndex with the items matching the non-empty _filter
+	void applyFilter(const Common::U32String &previousFilter);
+	bool isSubstringToken(const Common::U32String &token) const;
+	bool isNarrowedFilter(const Common::U32String &previousFilter, const Common::U32StringArray &tokens, uint &firstNewToken) const;
+	bool lookupFilterIndex(const Common::U32StringArray &tokens, Common::Array<int> &candidates) const;
+	void addToFilterIndex(int idx);
+
 	void receivedFocusWidget() override;
 	void lostFocusWidget() override;
 	void checkBounds();
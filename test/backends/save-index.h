@@ -0,0 +1,204 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/saves/default/save-index.h"
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "../null_osystem.h"
+
+#include <stdio.h>
+
+class SaveMetadataIndexTestSuite : public CxxTest::TestSuite {
+public:
+	void test_lookup_checks_stamp() {
+		SaveMetadataIndex index;
+		index.store("game.001", 100, 5, makeMetadata("first"));
+
+		Common::SaveFileMetadata metadata;
+		TS_ASSERT(index.lookup("game.001", 100, 5, metadata));
+		TS_ASSERT_EQUALS(metadata.description, "first");
+		TS_ASSERT_EQUALS(metadata.playTime, 1234u);
+		TS_ASSERT_EQUALS(metadata.thumbnail.size(), 3u);
+
+		// Lookups are case insensitive, like the save file names.
+		TS_ASSERT(index.lookup("GAME.001", 100, 5, metadata));
+
+		// A changed size or modification time drops the entry.
+		TS_ASSERT(!index.lookup("game.001", 100, 6, metadata));
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+
+		index.store("game.001", 100, 5, makeMetadata("first"));
+		TS_ASSERT(!index.lookup("game.001", 101, 5, metadata));
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+
+		TS_ASSERT(!index.lookup("game.002", 100, 5, metadata));
+	}
+
+	void test_invalidate() {
+		SaveMetadataIndex index;
+		index.store("game.001", 100, 5, makeMetadata("first"));
+		index.store("game.002", 200, 6, makeMetadata("second"));
+		index.invalidate("game.001");
+		index.invalidate("game.003");
+
+		Common::SaveFileMetadata metadata;
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+		TS_ASSERT(index.lookup("game.002", 200, 6, metadata));
+		TS_ASSERT_EQUALS(metadata.description, "second");
+	}
+
+	void test_drop_missing() {
+		SaveMetadataIndex index;
+		index.store("game.001", 100, 5, makeMetadata("first"));
+		index.store("game.002", 200, 6, makeMetadata("second"));
+		index.store("game.003", 300, 7, makeMetadata("third"));
+
+		Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> files;
+		files["game.002"] = true;
+		index.dropMissing(files);
+
+		Common::SaveFileMetadata metadata;
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+		TS_ASSERT(index.lookup("game.002", 200, 6, metadata));
+		TS_ASSERT(!index.lookup("game.003", 300, 7, metadata));
+	}
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+	void test_round_trip() {
+		Common::install_null_g_system();
+		const Common::Path directory = getDirectory();
+
+		{
+			SaveMetadataIndex index;
+			index.load(directory);
+			index.store("game.001", 100, 5, makeMetadata("first"));
+			index.store("game.002", 200, 6, makeMetadata("second"));
+			index.flush();
+		}
+
+		{
+			SaveMetadataIndex index;
+			index.load(directory);
+
+			Common::SaveFileMetadata metadata;
+			TS_ASSERT(index.lookup("game.001", 100, 5, metadata));
+			TS_ASSERT_EQUALS(metadata.description, "first");
+			TS_ASSERT_EQUALS(metadata.saveDate, 0x20261019u);
+			TS_ASSERT_EQUALS(metadata.saveTime, 0x1230);
+			TS_ASSERT_EQUALS(metadata.playTime, 1234u);
+			TS_ASSERT(metadata.isAutosave);
+			TS_ASSERT_EQUALS(metadata.thumbnail.size(), 3u);
+			TS_ASSERT_EQUALS(metadata.thumbnail[2], 3);
+
+			// The destructor writes out the dropped entry.
+			index.invalidate("game.002");
+		}
+
+		{
+			SaveMetadataIndex index;
+			index.load(directory);
+
+			Common::SaveFileMetadata metadata;
+			TS_ASSERT(index.lookup("game.001", 100, 5, metadata));
+			TS_ASSERT(!index.lookup("game.002", 200, 6, metadata));
+		}
+
+		removeIndex();
+	}
+
+	void test_corrupt_index_is_ignored() {
+		Common::install_null_g_system();
+		const Common::Path directory = getDirectory();
+
+		{
+			SaveMetadataIndex index;
+			index.load(directory);
+			index.store("game.001", 100, 5, makeMetadata("first"));
+		}
+
+		// Cut the file short in the middle of the entry.
+		writeIndex(MKTAG('S', 'V', 'I', 'X'), 1, 16);
+
+		SaveMetadataIndex index;
+		index.load(directory);
+		Common::SaveFileMetadata metadata;
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+
+		removeIndex();
+	}
+
+	void test_unknown_version_is_ignored() {
+		Common::install_null_g_system();
+		const Common::Path directory = getDirectory();
+
+		{
+			SaveMetadataIndex index;
+			index.load(directory);
+			index.store("game.001", 100, 5, makeMetadata("first"));
+		}
+
+		writeIndex(MKTAG('S', 'V', 'I', 'X'), 2, 0);
+
+		SaveMetadataIndex index;
+		index.load(directory);
+		Common::SaveFileMetadata metadata;
+		TS_ASSERT(!index.lookup("game.001", 100, 5, metadata));
+
+		removeIndex();
+	}
+#endif
+
+private:
+	static Common::SaveFileMetadata makeMetadata(const char *description) {
+		Common::SaveFileMetadata metadata;
+		metadata.description = description;
+		metadata.saveDate = 0x20261019;
+		metadata.saveTime = 0x1230;
+		metadata.playTime = 1234;
+		metadata.isAutosave = true;
+		metadata.thumbnail.push_back(1);
+		metadata.thumbnail.push_back(2);
+		metadata.thumbnail.push_back(3);
+		return metadata;
+	}
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+	static Common::Path getDirectory() {
+		return Common::FSNode(Common::Path(".")).getPath();
+	}
+
+	static Common::FSNode getIndexNode() {
+		return Common::FSNode(getDirectory()).getChild(SaveMetadataIndex::FILENAME);
+	}
+
+	/**
+	 * Rewrite the index file with the given header, keeping the first
+	 * @p keep bytes of the entries the file had before.
+	 */
+	static void writeIndex(uint32 tag, uint32 version, uint32 keep) {
+		const Common::FSNode node = getIndexNode();
+
+		Common::Array<byte> entries;
+		{
+			Common::ScopedPtr<Common::SeekableReadStream> in(node.createReadStream());
+			TS_ASSERT(in);
+			in->seek(8);
+			entries.resize(MIN<uint32>(keep, in->size() - in->pos()));
+			if (!entries.empty())
+				in->read(entries.data(), entries.size());
+		}
+
+		Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream());
+		TS_ASSERT(out);
+		out->writeUint32BE(tag);
+		out->writeUint32LE(version);
+		if (!entries.empty())
+			out->write(entries.data(), entries.size());
+		out->finalize();
+	}
+
+	static void removeIndex() {
+		remove(getIndexNode().getPath().toString(Common::Path::kNativeSeparator).c_str());
+	}
+#endif
+};
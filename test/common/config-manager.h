@@ -0,0 +1,127 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/file.h"
+#include "common/system.h"
+#include "../null_osystem.h"
+
+#include <stdio.h>
+
+class ConfigManagerTestSuite : public CxxTest::TestSuite {
+	void writeSyntheticConfig(const Common::Path &path, int numTargets) {
+		Common::DumpFile file;
+		TS_ASSERT(file.open(path));
+
+		file.writeString("[scummvm]\ngui_theme=scummremastered\nversioninfo=2.9.0git\n\n");
+		file.writeString("[keymapper]\nkeymap_global_MENU=C+F5\n\n");
+		for (int i = 0; i < numTargets; i++) {
+			file.writeString(Common::String::format("# Target %d\n[target%d]\n", i, i));
+			file.writeString(Common::String::format("description=Synthetic game %d\ngameid=game%d\nengineid=scumm\n", i, i));
+			file.writeString(Common::String::format("path=/games/target%d\nlanguage=en\nplatform=pc\n\n", i));
+		}
+	}
+
+	void removeConfig(const Common::Path &path) {
+		remove(path.toString(Common::Path::kNativeSeparator).c_str());
+	}
+
+public:
+	void test_unmodified_domains() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const Common::Path path("config_manager_test.ini");
+		writeSyntheticConfig(path, 100);
+
+		ConfMan.setActiveDomain("");
+		TS_ASSERT(ConfMan.loadConfigFile(path, Common::Path()));
+		TS_ASSERT(ConfMan.hasGameDomain("target42"));
+		TS_ASSERT(!ConfMan.hasMiscDomain("target42"));
+		TS_ASSERT_EQUALS(ConfMan.get("gui_theme", "scummvm"), "scummremastered");
+		TS_ASSERT_EQUALS(ConfMan.get("keymap_global_MENU", "keymapper"), "C+F5");
+
+		ConfMan.setActiveDomain("target42");
+		TS_ASSERT_EQUALS(ConfMan.get("description"), "Synthetic game 42");
+		TS_ASSERT_EQUALS(ConfMan.getActiveDomain()->getDomainComment(), "# Target 42\n");
+		TS_ASSERT(!ConfMan.getActiveDomain()->isDirty());
+
+		// Reading from a domain must not mark it as modified
+		Common::ConfigManager::Domain *domain = ConfMan.getDomain("target41");
+		TS_ASSERT_EQUALS(domain->getVal("gameid"), "game41");
+		TS_ASSERT(!domain->isDirty());
+
+		ConfMan.set("language", "de");
+		TS_ASSERT(ConfMan.getActiveDomain()->isDirty());
+		ConfMan.flushToDisk();
+		TS_ASSERT(!ConfMan.getActiveDomain()->isDirty());
+
+		// Reload, and check that both modified and untouched domains survived
+		ConfMan.setActiveDomain("");
+		TS_ASSERT(ConfMan.loadConfigFile(path, Common::Path()));
+		TS_ASSERT_EQUALS(ConfMan.get("language", "target42"), "de");
+		TS_ASSERT_EQUALS(ConfMan.get("language", "target43"), "en");
+		TS_ASSERT_EQUALS(ConfMan.get("path", "target99"), "/games/target99");
+		TS_ASSERT_EQUALS(ConfMan.getDomain("target43")->getDomainComment(), "# Target 43\n");
+
+		// Removed domains must disappear from the file as well
+		ConfMan.removeGameDomain("target43");
+		ConfMan.flushToDisk();
+		TS_ASSERT(ConfMan.loadConfigFile(path, Common::Path()));
+		TS_ASSERT(!ConfMan.hasGameDomain("target43"));
+		TS_ASSERT(ConfMan.hasGameDomain("target44"));
+
+		removeConfig(path);
+#endif
+	}
+
+	void test_synthetic_10k_targets() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const Common::Path path("config_manager_test.ini");
+		const int numTargets = 10000;
+#ifdef SLOW_TESTS
+		const int iters = 20;
+#else
+		const int iters = 1;
+#endif
+		writeSyntheticConfig(path, numTargets);
+
+		uint32 loadTime = 0, flushTime = 0, fullFlushTime = 0;
+		for (int i = 0; i < iters; i++) {
+			ConfMan.setActiveDomain("");
+
+			// Startup: load the file and launch a single target
+			uint32 start = g_system->getMillis();
+			TS_ASSERT(ConfMan.loadConfigFile(path, Common::Path()));
+			ConfMan.setActiveDomain("target5000");
+			TS_ASSERT_EQUALS(ConfMan.get("gameid"), "game5000");
+			loadTime += g_system->getMillis() - start;
+
+			// Flush after changing a single setting
+			start = g_system->getMillis();
+			ConfMan.setInt("iteration", i);
+			ConfMan.flushToDisk();
+			flushTime += g_system->getMillis() - start;
+
+			// Flush after touching every target, which has to rewrite everything
+			start = g_system->getMillis();
+			for (int j = 0; j < numTargets; j++)
+				ConfMan.setInt("iteration", i, Common::String::format("target%d", j));
+			ConfMan.flushToDisk();
+			fullFlushTime += g_system->getMillis() - start;
+		}
+
+		ConfMan.setActiveDomain("");
+		TS_ASSERT(ConfMan.loadConfigFile(path, Common::Path()));
+		TS_ASSERT_EQUALS(ConfMan.getGameDomains().size(), (uint)numTargets);
+		TS_ASSERT_EQUALS(ConfMan.getInt("iteration", "target0"), iters - 1);
+		TS_ASSERT_EQUALS(ConfMan.getInt("iteration", "target9999"), iters - 1);
+
+		debug("ConfigManager load with %d targets avg time (in milliseconds): %f", numTargets, (double)loadTime / iters);
+		debug("ConfigManager flush after a single change avg time (in milliseconds): %f", (double)flushTime / iters);
+		debug("ConfigManager flush after changing all targets avg time (in milliseconds): %f", (double)fullFlushTime / iters);
+
+		removeConfig(path);
+#endif
+	}
+};